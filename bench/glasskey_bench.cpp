@@ -0,0 +1,396 @@
+/** Micro-benchmarks for the core TextGrid operations.
+ *
+ *  Usage: glasskey_bench [--output PATH] [--filter TEXT] [--min-time SECONDS]
+ *
+ *  Every benchmark is run at several grid sizes, and the results are written
+ *  as JSON to PATH (or standard output) so that they can be compared across
+ *  releases. A summary table is printed to standard error.
+ */
+
+#include "glasskey/glasskey.h"
+#include "glasskey/cpu_renderer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef GLASSKEY_VERSION
+#define GLASSKEY_VERSION "unknown"
+#endif
+
+namespace
+{
+const int SAMPLES = 5;
+
+struct GridSize
+{
+    gk::Size rows;
+    gk::Size cols;
+};
+
+const GridSize GRID_SIZES[] = {{24, 80}, {60, 200}, {200, 400}, {270, 480}};
+
+/** The result of timing one benchmark at one grid size */
+struct Result
+{
+    std::string name;
+    GridSize size;
+    std::uint64_t iterations;
+    double ns_per_op;
+    double ns_per_cell;
+    std::uint64_t cells_per_op;
+};
+
+/** Options given on the command line */
+struct Options
+{
+    std::string output;
+    std::string filter;
+    double min_time = 0.1;
+};
+
+/** Keeps values computed by a benchmark from being optimized away */
+volatile std::uint32_t g_sink;
+
+/** Runs an operation repeatedly and returns the median time per call in
+ *  nanoseconds. The number of calls per sample is doubled until a sample
+ *  takes at least the minimum time.
+ */
+double time_op(const std::function<void(std::uint64_t)> &op, double min_time, std::uint64_t &iterations)
+{
+    using clock = std::chrono::steady_clock;
+    iterations = 1;
+    while (true)
+    {
+        auto start = clock::now();
+        op(iterations);
+        double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+        if (elapsed >= min_time || iterations >= (1ull << 40))
+        {
+            break;
+        }
+
+        iterations *= 2;
+    }
+
+    std::vector<double> samples;
+    for (int i = 0; i < SAMPLES; ++i)
+    {
+        auto start = clock::now();
+        op(iterations);
+        samples.push_back(std::chrono::duration<double, std::nano>(clock::now() - start).count() / iterations);
+    }
+
+    std::sort(samples.begin(), samples.end());
+    return samples[SAMPLES / 2];
+}
+
+/** A named benchmark, which prepares an operation for a given grid size and
+ *  reports the number of cells the operation touches.
+ */
+struct Benchmark
+{
+    std::string name;
+    std::function<std::function<void(std::uint64_t)>(const GridSize &, std::uint64_t &)> setup;
+};
+
+/** A frame which is drawn with a CpuRenderer, as the headless backend does */
+struct RenderFrame
+{
+    RenderFrame(const GridSize &size) : size(size),
+                                        renderer(size.rows, size.cols),
+                                        cells(static_cast<std::size_t>(size.rows) * size.cols, gk::Cell{'x', 0}),
+                                        palette(1, gk::Colors::White),
+                                        row_versions(size.rows, 1),
+                                        version(1)
+    {
+        renderer.render(view());
+    }
+
+    /** Marks rows as changed and renders the frame */
+    void render(gk::Size first_row, gk::Size last_row)
+    {
+        ++version;
+        std::fill(row_versions.begin() + first_row, row_versions.begin() + last_row, version);
+        renderer.render(view());
+    }
+
+    gk::FrameView view() const
+    {
+        return {size.rows, size.cols, cells.data(), &palette, row_versions.data(), version, nullptr, 0, 0};
+    }
+
+    GridSize size;
+    gk::CpuRenderer renderer;
+    gk::CellBuffer cells;
+    std::vector<gk::Color> palette;
+    std::vector<std::uint64_t> row_versions;
+    std::uint64_t version;
+};
+
+std::string line_of(gk::Size cols)
+{
+    std::string line(cols, ' ');
+    for (gk::Size col = 0; col < cols; ++col)
+    {
+        line[col] = static_cast<char>('a' + col % 26);
+    }
+
+    return line;
+}
+
+std::vector<Benchmark> benchmarks()
+{
+    std::vector<Benchmark> result;
+
+    result.push_back({"draw_string", [](const GridSize &size, std::uint64_t &cells) {
+                          auto grid = gk::create_grid(size.rows, size.cols);
+                          grid->map_color('e', gk::Colors::Red);
+                          cells = size.cols;
+                          return [grid, line = line_of(size.cols), size](std::uint64_t n) {
+                              for (std::uint64_t i = 0; i < n; ++i)
+                              {
+                                  grid->draw(static_cast<gk::Index>(i % size.rows), 0, line);
+                              }
+                          };
+                      }});
+
+    result.push_back({"draw_letters", [](const GridSize &size, std::uint64_t &cells) {
+                          auto grid = gk::create_grid(size.rows, size.cols);
+                          std::vector<gk::Letter> letters;
+                          for (gk::Size col = 0; col < size.cols; ++col)
+                          {
+                              letters.emplace_back(static_cast<char>('a' + col % 26), col % 2 ? gk::Colors::Red : gk::Colors::Blue);
+                          }
+
+                          cells = size.cols;
+                          return [grid, letters, size](std::uint64_t n) {
+                              for (std::uint64_t i = 0; i < n; ++i)
+                              {
+                                  grid->draw(static_cast<gk::Index>(i % size.rows), 0, letters);
+                              }
+                          };
+                      }});
+
+    result.push_back({"draw_rect", [](const GridSize &size, std::uint64_t &cells) {
+                          auto grid = gk::create_grid(size.rows, size.cols);
+                          cells = static_cast<std::uint64_t>(size.rows) * size.cols;
+                          return [grid, size](std::uint64_t n) {
+                              for (std::uint64_t i = 0; i < n; ++i)
+                              {
+                                  grid->draw(gk::Rect(0, 0, size.cols, size.rows), static_cast<char>('a' + i % 26));
+                              }
+                          };
+                      }});
+
+    result.push_back({"clear_row", [](const GridSize &size, std::uint64_t &cells) {
+                          auto grid = gk::create_grid(size.rows, size.cols);
+                          cells = size.cols;
+                          return [grid, size](std::uint64_t n) {
+                              for (std::uint64_t i = 0; i < n; ++i)
+                              {
+                                  grid->clear(static_cast<gk::Index>(i % size.rows), 0, size.cols);
+                              }
+                          };
+                      }});
+
+    result.push_back({"clear_rect", [](const GridSize &size, std::uint64_t &cells) {
+                          auto grid = gk::create_grid(size.rows, size.cols);
+                          cells = static_cast<std::uint64_t>(size.rows) * size.cols;
+                          return [grid, size](std::uint64_t n) {
+                              for (std::uint64_t i = 0; i < n; ++i)
+                              {
+                                  grid->clear(gk::Rect(0, 0, size.cols, size.rows));
+                              }
+                          };
+                      }});
+
+    // get_color is private, so it is measured through recolor(), which does
+    // nothing but look up the mapped color of every cell in the region
+    result.push_back({"get_color", [](const GridSize &size, std::uint64_t &cells) {
+                          auto grid = gk::create_grid(size.rows, size.cols);
+                          grid->map_color('a', gk::Colors::Red).map_color('m', gk::Colors::Green);
+                          std::string line = line_of(size.cols);
+                          for (gk::Size row = 0; row < size.rows; ++row)
+                          {
+                              grid->draw(row, 0, line);
+                          }
+
+                          cells = static_cast<std::uint64_t>(size.rows) * size.cols;
+                          return [grid, size](std::uint64_t n) {
+                              for (std::uint64_t i = 0; i < n; ++i)
+                              {
+                                  grid->recolor(gk::Rect(0, 0, size.cols, size.rows));
+                              }
+                          };
+                      }});
+
+    result.push_back({"rect_clip", [](const GridSize &size, std::uint64_t &cells) {
+                          std::vector<gk::Rect> rects;
+                          for (int i = 0; i < 64; ++i)
+                          {
+                              rects.emplace_back(static_cast<gk::Index>(i * 7 % size.cols - size.cols / 4),
+                                                 static_cast<gk::Index>(i * 5 % size.rows - size.rows / 4),
+                                                 static_cast<gk::Size>(size.cols / 2), static_cast<gk::Size>(size.rows / 2));
+                          }
+
+                          cells = 0;
+                          return [rects, size](std::uint64_t n) {
+                              std::uint32_t area = 0;
+                              for (std::uint64_t i = 0; i < n; ++i)
+                              {
+                                  area += rects[i % rects.size()].clip(size.cols, size.rows).area();
+                              }
+
+                              g_sink = area;
+                          };
+                      }});
+
+    // the headless backend draws frames with CpuRenderer, so it is driven
+    // directly to leave out the copy made by read_pixels()
+    result.push_back({"cpu_render_full", [](const GridSize &size, std::uint64_t &cells) {
+                          auto frame = std::make_shared<RenderFrame>(size);
+                          cells = static_cast<std::uint64_t>(size.rows) * size.cols;
+                          return [frame](std::uint64_t n) {
+                              for (std::uint64_t i = 0; i < n; ++i)
+                              {
+                                  frame->render(0, frame->size.rows);
+                              }
+                          };
+                      }});
+
+    result.push_back({"cpu_render_row", [](const GridSize &size, std::uint64_t &cells) {
+                          auto frame = std::make_shared<RenderFrame>(size);
+                          cells = size.cols;
+                          return [frame](std::uint64_t n) {
+                              for (std::uint64_t i = 0; i < n; ++i)
+                              {
+                                  gk::Size row = static_cast<gk::Size>(i % frame->size.rows);
+                                  frame->render(row, row + 1);
+                              }
+                          };
+                      }});
+
+    result.push_back({"blit_row", [](const GridSize &size, std::uint64_t &cells) {
+                          auto grid = gk::create_grid(size.rows, size.cols);
+                          cells = size.cols;
+                          return [grid, line = line_of(size.cols), size](std::uint64_t n) {
+                              for (std::uint64_t i = 0; i < n; ++i)
+                              {
+                                  grid->draw(static_cast<gk::Index>(i % size.rows), 0, line);
+                                  grid->blit();
+                              }
+                          };
+                      }});
+
+    return result;
+}
+
+bool parse_options(int argc, char *argv[], Options &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (i + 1 < argc && arg == "--output")
+        {
+            options.output = argv[++i];
+        }
+        else if (i + 1 < argc && arg == "--filter")
+        {
+            options.filter = argv[++i];
+        }
+        else if (i + 1 < argc && arg == "--min-time")
+        {
+            options.min_time = std::stod(argv[++i]);
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--output PATH] [--filter TEXT] [--min-time SECONDS]" << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void write_json(std::ostream &out, const std::vector<Result> &results)
+{
+    out << "{\n  \"library\": \"glasskey\",\n  \"version\": \"" << GLASSKEY_VERSION << "\",\n  \"results\": [";
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const Result &result = results[i];
+        out << (i ? ",\n" : "\n")
+            << "    {\"name\": \"" << result.name
+            << "\", \"rows\": " << result.size.rows
+            << ", \"cols\": " << result.size.cols
+            << ", \"iterations\": " << result.iterations
+            << ", \"ns_per_op\": " << result.ns_per_op
+            << ", \"cells_per_op\": " << result.cells_per_op
+            << ", \"ns_per_cell\": ";
+        if (result.cells_per_op)
+        {
+            out << result.ns_per_cell;
+        }
+        else
+        {
+            out << "null";
+        }
+
+        out << "}";
+    }
+
+    out << "\n  ]\n}\n";
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    Options options;
+    if (!parse_options(argc, argv, options))
+    {
+        return 1;
+    }
+
+    // grids are only drawn to, never shown, so no window or thread is needed
+    gk::set_backend(gk::BackendType::HEADLESS);
+
+    std::vector<Result> results;
+    for (const auto &benchmark : benchmarks())
+    {
+        if (benchmark.name.find(options.filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        for (const auto &size : GRID_SIZES)
+        {
+            Result result{benchmark.name, size, 0, 0, 0, 0};
+            auto op = benchmark.setup(size, result.cells_per_op);
+            result.ns_per_op = time_op(op, options.min_time, result.iterations);
+            result.ns_per_cell = result.cells_per_op ? result.ns_per_op / result.cells_per_op : 0;
+            results.push_back(result);
+
+            char line[128];
+            std::snprintf(line, sizeof(line), "%-16s %4ux%-4u %12.1f ns/op %10.3f ns/cell\n", result.name.c_str(),
+                          size.rows, size.cols, result.ns_per_op, result.ns_per_cell);
+            std::cerr << line;
+        }
+    }
+
+    if (options.output.empty())
+    {
+        write_json(std::cout, results);
+    }
+    else
+    {
+        std::ofstream file(options.output);
+        write_json(file, results);
+    }
+
+    return 0;
+}
@@ -0,0 +1,169 @@
+"""Measures the overhead of calling glasskey from Python.
+
+Each benchmark makes the same calls as the matching benchmark in
+glasskey_bench, so the difference between the two results is the cost of
+crossing the binding. Results are written as JSON in the same format.
+
+Usage: python python_bench.py [--output PATH] [--filter TEXT] [--min-time SECONDS]
+"""
+
+import argparse
+import importlib.metadata
+import json
+import statistics
+import sys
+import time
+
+import glasskey as gk
+
+SAMPLES = 5
+GRID_SIZES = [(24, 80), (60, 200), (200, 400), (270, 480)]
+
+
+def time_op(op, min_time):
+    """Returns the median time per call in nanoseconds, and the number of
+    calls per sample."""
+    iterations = 1
+    while True:
+        start = time.perf_counter()
+        op(iterations)
+        if time.perf_counter() - start >= min_time:
+            break
+
+        iterations *= 2
+
+    samples = []
+    for _ in range(SAMPLES):
+        start = time.perf_counter()
+        op(iterations)
+        samples.append((time.perf_counter() - start) * 1e9 / iterations)
+
+    return statistics.median(samples), iterations
+
+
+def line_of(cols):
+    return "".join(chr(ord("a") + col % 26) for col in range(cols))
+
+
+def draw_string(rows, cols):
+    grid = gk.create_grid(rows, cols)
+    line = line_of(cols)
+
+    def op(n):
+        for i in range(n):
+            grid.draw(i % rows, 0, line)
+
+    return op, cols
+
+
+def draw_letters(rows, cols):
+    grid = gk.create_grid(rows, cols)
+    letters = [gk.Letter(chr(ord("a") + col % 26), gk.Colors.Red if col % 2 else gk.Colors.Blue)
+               for col in range(cols)]
+
+    def op(n):
+        for i in range(n):
+            grid.draw(i % rows, 0, letters)
+
+    return op, cols
+
+
+def draw_rect(rows, cols):
+    grid = gk.create_grid(rows, cols)
+    rect = gk.Rect(0, 0, cols, rows)
+
+    def op(n):
+        for i in range(n):
+            grid.draw(rect, chr(ord("a") + i % 26))
+
+    return op, rows * cols
+
+
+def clear_row(rows, cols):
+    grid = gk.create_grid(rows, cols)
+
+    def op(n):
+        for i in range(n):
+            grid.clear(i % rows, 0, cols)
+
+    return op, cols
+
+
+def lock_cells(rows, cols):
+    grid = gk.create_grid(rows, cols)
+
+    def op(n):
+        for i in range(n):
+            with grid.lock_cells() as cells:
+                cells.values[:] = 97 + i % 26
+
+    return op, rows * cols
+
+
+def blit_row(rows, cols):
+    grid = gk.create_grid(rows, cols)
+    line = line_of(cols)
+
+    def op(n):
+        for i in range(n):
+            grid.draw(i % rows, 0, line)
+            grid.blit()
+
+    return op, cols
+
+
+BENCHMARKS = [
+    ("draw_string", draw_string),
+    ("draw_letters", draw_letters),
+    ("draw_rect", draw_rect),
+    ("clear_row", clear_row),
+    ("lock_cells", lock_cells),
+    ("blit_row", blit_row),
+]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Python binding benchmarks for glasskey")
+    parser.add_argument("--output", help="path of the JSON file to write")
+    parser.add_argument("--filter", default="", help="only run benchmarks whose names contain this")
+    parser.add_argument("--min-time", type=float, default=0.1, help="minimum seconds per sample")
+    args = parser.parse_args()
+
+    # grids are only drawn to, never shown, so no window or thread is needed
+    gk.set_backend(gk.BackendType.Headless)
+
+    results = []
+    for name, setup in BENCHMARKS:
+        if args.filter not in name:
+            continue
+
+        for rows, cols in GRID_SIZES:
+            op, cells = setup(rows, cols)
+            ns_per_op, iterations = time_op(op, args.min_time)
+            results.append({
+                "name": "python_" + name,
+                "rows": rows,
+                "cols": cols,
+                "iterations": iterations,
+                "ns_per_op": ns_per_op,
+                "cells_per_op": cells,
+                "ns_per_cell": ns_per_op / cells
+            })
+            print("{:<22} {:>4}x{:<4} {:>12.1f} ns/op {:>10.3f} ns/cell".format(
+                "python_" + name, rows, cols, ns_per_op, ns_per_op / cells), file=sys.stderr)
+
+    try:
+        version = importlib.metadata.version("glasskey")
+    except importlib.metadata.PackageNotFoundError:
+        version = "unknown"
+
+    report = {"library": "glasskey-python", "version": version, "results": results}
+    if args.output:
+        with open(args.output, "w") as file:
+            json.dump(report, file, indent=2)
+    else:
+        json.dump(report, sys.stdout, indent=2)
+
+
+if __name__ == "__main__":
+    main()
@@ -12,12 +12,24 @@
 #ifndef _GK_H_
 #define _GK_H_
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
 #include <cstdint>
 #include <cmath>
+#include <deque>
+#include <fstream>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace gk
@@ -25,6 +37,7 @@ namespace gk
 
 const int COL_WIDTH = 9;
 const int ROW_HEIGHT = 15;
+const std::size_t CACHE_LINE_SIZE = 64;
 
 /** Type of signed index offsets into a grid */
 typedef std::int16_t Index;
@@ -32,84 +45,206 @@ typedef std::int16_t Index;
 /** Type of unsigned grid sizes */
 typedef std::uint16_t Size;
 
-/** Class representing an RGB color, where RGB are floating-point values from [0, 1] */
+/** Type of the compact handles which refer to entries in a grid's color palette */
+typedef std::uint16_t ColorHandle;
+
+/** Allocator which places its storage at the start of a cache line */
+template <typename T>
+class CacheAlignedAllocator
+{
+public:
+    typedef T value_type;
+
+    CacheAlignedAllocator() = default;
+
+    template <typename U>
+    CacheAlignedAllocator(const CacheAlignedAllocator<U> &) {}
+
+    T *allocate(std::size_t count)
+    {
+        return static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t(CACHE_LINE_SIZE)));
+    }
+
+    void deallocate(T *ptr, std::size_t)
+    {
+        ::operator delete(ptr, std::align_val_t(CACHE_LINE_SIZE));
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const CacheAlignedAllocator<T> &, const CacheAlignedAllocator<U> &)
+{
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const CacheAlignedAllocator<T> &, const CacheAlignedAllocator<U> &)
+{
+    return false;
+}
+
+/** Class representing an RGB color, packed into a single 32-bit RGBA8 value.
+ *  Channels are exposed as floating-point values from [0, 1] for rendering.
+ */
 class Color
 {
 public:
     /** Default constructor. */
-    Color();
+    constexpr Color() : m_rgba(0xFF000000u) {}
 
     /** Constructor.
      * \param red Red channel [0,1]
      * \param green Green channel [0,1]
      * \param blue Blue channel [0,1]
      */
-    Color(std::float_t red, std::float_t green, std::float_t blue);
+    constexpr Color(std::float_t red, std::float_t green, std::float_t blue) : m_rgba(pack(to_byte(red), to_byte(green), to_byte(blue), 255))
+    {
+    }
 
     /** Construct a color object from RGB byte values.
      * \param red Red channel
      * \param green Green channel
      * \param blue Blue channel
+     * \param alpha Alpha channel
+     * \return a valid color object
+     */
+    static constexpr Color from_bytes(std::uint8_t red, std::uint8_t green, std::uint8_t blue, std::uint8_t alpha = 255)
+    {
+        return from_rgba(pack(red, green, blue, alpha));
+    }
+
+    /** Construct a color object from a packed RGBA8 value.
+     * \param rgba the packed value, with red in the lowest byte
      * \return a valid color object
      */
-    static Color from_bytes(std::uint8_t red, std::uint8_t green, std::uint8_t blue);
+    static constexpr Color from_rgba(std::uint32_t rgba)
+    {
+        Color color;
+        color.m_rgba = rgba;
+        return color;
+    }
 
     /** Equality operator.
      *  \param other the color to compare with
      *  \return whether the colors have the same values
      */
-    bool operator==(const Color &other) const;
+    constexpr bool operator==(const Color &other) const
+    {
+        return m_rgba == other.m_rgba;
+    }
 
     /** Inequality operator.
      *  \param other the color to compare with
      *  \return whether the colors have different values
      */
-    bool operator!=(const Color &other) const;
+    constexpr bool operator!=(const Color &other) const
+    {
+        return m_rgba != other.m_rgba;
+    }
 
     /** The red value [0,1] */
-    std::float_t red() const;
+    std::float_t red() const
+    {
+        return (m_rgba & 0xFF) / 255.0f;
+    }
 
     /** The green value [0,1] */
-    std::float_t green() const;
+    std::float_t green() const
+    {
+        return ((m_rgba >> 8) & 0xFF) / 255.0f;
+    }
 
     /** The blue value [0,1] */
-    std::float_t blue() const;
+    std::float_t blue() const
+    {
+        return ((m_rgba >> 16) & 0xFF) / 255.0f;
+    }
+
+    /** The alpha value [0,1] */
+    std::float_t alpha() const
+    {
+        return (m_rgba >> 24) / 255.0f;
+    }
+
+    /** The packed RGBA8 value, with red in the lowest byte */
+    constexpr std::uint32_t rgba() const
+    {
+        return m_rgba;
+    }
 
     /** Represents of the state of the object as a string */
     std::string to_string() const;
 
 private:
-    std::float_t m_red;
-    std::float_t m_green;
-    std::float_t m_blue;
+    static constexpr std::uint8_t to_byte(std::float_t value)
+    {
+        return value <= 0.0f ? 0 : value >= 1.0f ? 255 : static_cast<std::uint8_t>(value * 255.0f + 0.5f);
+    }
+
+    static constexpr std::uint32_t pack(std::uint8_t red, std::uint8_t green, std::uint8_t blue, std::uint8_t alpha)
+    {
+        return static_cast<std::uint32_t>(red) |
+               static_cast<std::uint32_t>(green) << 8 |
+               static_cast<std::uint32_t>(blue) << 16 |
+               static_cast<std::uint32_t>(alpha) << 24;
+    }
+
+    std::uint32_t m_rgba;
 };
 
 namespace Colors
 {
-const Color Black = Color::from_bytes(0, 0, 0);
-const Color White = Color::from_bytes(255, 255, 255);
-const Color Red = Color::from_bytes(255, 0, 0);
-const Color Maroon = Color::from_bytes(128, 0, 0);
-const Color Pink = Color::from_bytes(255, 200, 220);
-const Color Brown = Color::from_bytes(170, 110, 40);
-const Color Orange = Color::from_bytes(255, 150, 0);
-const Color Coral = Color::from_bytes(255, 215, 180);
-const Color Olive = Color::from_bytes(128, 128, 0);
-const Color Yellow = Color::from_bytes(255, 235, 0);
-const Color Beige = Color::from_bytes(255, 250, 200);
-const Color Lime = Color::from_bytes(190, 255, 0);
-const Color Green = Color::from_bytes(0, 190, 0);
-const Color Mint = Color::from_bytes(170, 255, 195);
-const Color Teal = Color::from_bytes(0, 128, 128);
-const Color Cyan = Color::from_bytes(100, 255, 255);
-const Color Navy = Color::from_bytes(0, 0, 128);
-const Color Blue = Color::from_bytes(67, 133, 255);
-const Color Purple = Color::from_bytes(130, 0, 150);
-const Color Lavender = Color::from_bytes(230, 190, 255);
-const Color Magenta = Color::from_bytes(255, 0, 255);
-const Color Gray = Color::from_bytes(128, 128, 128);
+constexpr Color Black = Color::from_bytes(0, 0, 0);
+constexpr Color White = Color::from_bytes(255, 255, 255);
+constexpr Color Red = Color::from_bytes(255, 0, 0);
+constexpr Color Maroon = Color::from_bytes(128, 0, 0);
+constexpr Color Pink = Color::from_bytes(255, 200, 220);
+constexpr Color Brown = Color::from_bytes(170, 110, 40);
+constexpr Color Orange = Color::from_bytes(255, 150, 0);
+constexpr Color Coral = Color::from_bytes(255, 215, 180);
+constexpr Color Olive = Color::from_bytes(128, 128, 0);
+constexpr Color Yellow = Color::from_bytes(255, 235, 0);
+constexpr Color Beige = Color::from_bytes(255, 250, 200);
+constexpr Color Lime = Color::from_bytes(190, 255, 0);
+constexpr Color Green = Color::from_bytes(0, 190, 0);
+constexpr Color Mint = Color::from_bytes(170, 255, 195);
+constexpr Color Teal = Color::from_bytes(0, 128, 128);
+constexpr Color Cyan = Color::from_bytes(100, 255, 255);
+constexpr Color Navy = Color::from_bytes(0, 0, 128);
+constexpr Color Blue = Color::from_bytes(67, 133, 255);
+constexpr Color Purple = Color::from_bytes(130, 0, 150);
+constexpr Color Lavender = Color::from_bytes(230, 190, 255);
+constexpr Color Magenta = Color::from_bytes(255, 0, 255);
+constexpr Color Gray = Color::from_bytes(128, 128, 128);
 } // namespace Colors
 
+/** The systems which can be used to display grids */
+enum class BackendType
+{
+    /** Each grid is shown in its own OpenGL window */
+    OPENGL,
+
+    /** Grids are rasterized on the CPU into in-memory images, which can be
+     *  read back with read_pixels(). Needs neither a display nor a GPU.
+     */
+    HEADLESS,
+
+    /** Grids are drawn as text on the terminal attached to standard output
+     *  using ANSI escape sequences, e.g. over SSH. Only changed cells are sent.
+     */
+    TERMINAL
+};
+
+/** Selects the system used to display grids. Must be called before init()
+ *  or start(), and has no effect afterwards. The default is OPENGL.
+ *
+ *  \param backend the backend to use
+ */
+void set_backend(BackendType backend);
+
+/** The system used to display grids */
+BackendType backend();
+
 /** Initializes the underlying OpenGL context. Pass any OS-specific parameters via
  *  this method. Will be called by default the first time start() is called otherwise.
  * 
@@ -134,10 +269,74 @@ enum class Key {
     ENTER
 };
 
-/** Returns whether a key is pressed */
+/** Returns whether a key is pressed. Wait-free, so it can be polled from any
+ *  thread as often as needed.
+ */
 bool is_pressed(Key key);
 
+/** Returns whether any key is pressed, by the code it is reported with in
+ *  KeyEvent. Wait-free.
+ *
+ *  \param code the character, or the backend's code for a special key
+ *  \param is_special whether the code is for a special key
+ */
+bool is_pressed(int code, bool is_special = false);
+
+/** A key being pressed or released */
+struct KeyEvent
+{
+    /** When the backend received the event, in seconds on the steady clock
+     *  (the clock of Python's time.monotonic())
+     */
+    double time;
+
+    /** The character, or the backend's code for a special key */
+    int code;
+
+    /** Whether the code is for a special key, such as an arrow or function key */
+    bool is_special;
+
+    /** Whether the key was pressed, rather than released */
+    bool is_pressed;
+
+    /** Whether the key is one of the values of Key */
+    bool has_key;
+
+    /** The key, if has_key is set */
+    Key key;
+};
+
+/** The number of key events which are kept until drained. Later events are
+ *  dropped while the queue is full.
+ */
+const std::size_t KEY_EVENT_CAPACITY = 256;
+
+/** Removes the key events received since the last drain, oldest first. Any
+ *  number of threads can drain events, and each event is returned to only
+ *  one of them. Events are kept even when they arrive between two polls of
+ *  is_pressed(), so quick taps are never missed.
+ *
+ *  \param events the events are appended to this
+ *  \return the number of events appended
+ */
+std::size_t drain_key_events(std::vector<KeyEvent> &events);
+
+/** Removes the key events received since the last drain, oldest first.
+ *
+ *  \return the events
+ */
+std::vector<KeyEvent> drain_key_events();
+
+/** The number of key events dropped because the queue was full */
+std::uint64_t dropped_key_events();
+
 class TextGrid;
+class Layer;
+class FrameRenderer;
+struct FrameView;
+class FrameRecorder;
+class MappedFile;
+class Camera;
 
 /** Creates a new TextGrid.
  * 
@@ -149,18 +348,197 @@ class TextGrid;
  */
 std::shared_ptr<TextGrid> create_grid(Size rows, Size cols, const std::string &title = "Title", const Color &default_color = Colors::White);
 
+/** An image stored as packed RGBA8 pixels (red in the lowest byte), in rows from top to bottom */
+struct Image
+{
+    /** The width in pixels */
+    std::uint32_t width;
+
+    /** The height in pixels */
+    std::uint32_t height;
+
+    /** The pixels of the image */
+    std::vector<std::uint32_t> pixels;
+};
+
+/** Reads back the most recently blitted frame of a grid as pixels. Only
+ *  supported by the HEADLESS backend, which renders the frame on demand if
+ *  the render thread has not done so yet. May be called from any thread.
+ *
+ *  \param text_grid the grid to read
+ *  \param image receives the pixels
+ *  \return whether the backend supports reading back pixels. False until
+ *          the backend has been initialized by init() or start().
+ */
+bool read_pixels(const std::shared_ptr<TextGrid> &text_grid, Image &image);
+
 /** Destroys a text grid object.
  * 
  *  \param text_grid the grid to destroy
  */
 void destroy_grid(std::shared_ptr<TextGrid> text_grid);
 
-/** Blocking call that waits for the next frame of animation.
+/** Timing statistics gathered by a FramePacer */
+struct FramePacerStats
+{
+    /** The number of frames which have been paced */
+    std::uint64_t frames;
+
+    /** The number of frames which were already past their deadline when waited for */
+    std::uint64_t missed_deadlines;
+
+    /** The mean absolute difference between frame intervals and the target period, in seconds */
+    double mean_jitter;
+
+    /** The largest absolute difference between a frame interval and the target period, in seconds */
+    double max_jitter;
+
+    /** The frame rate actually achieved */
+    double effective_fps;
+};
+
+/** Class which paces a loop to a target frame rate. Frames are scheduled on
+ *  absolute deadlines, so that time spent between calls to wait() does not
+ *  accumulate as drift. The pacer sleeps until shortly before each deadline
+ *  and spins for the remainder to reach sub-millisecond accuracy.
+ */
+class FramePacer
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    /** Constructor.
+     *
+     *  \param frames_per_second the target frame rate
+     */
+    FramePacer(float frames_per_second = 30.0f);
+
+    /** Blocks until the deadline for the next frame. If the deadline has
+     *  already passed by more than a whole frame, the schedule restarts from
+     *  now rather than rushing through the missed frames.
+     */
+    void wait();
+
+    /** Restarts the schedule and clears the statistics */
+    void reset();
+
+    /** Changes the target frame rate. Takes effect from the next frame.
+     *
+     *  \param frames_per_second the target frame rate
+     */
+    void set_rate(float frames_per_second);
+
+    /** The target frame rate */
+    float rate() const;
+
+    /** The timing statistics gathered since construction or the last reset */
+    FramePacerStats stats() const;
+
+private:
+    float m_rate;
+    Clock::duration m_period;
+    Clock::time_point m_deadline;
+    Clock::time_point m_start;
+    Clock::time_point m_last_frame;
+    bool m_is_started;
+    std::uint64_t m_frames;
+    std::uint64_t m_missed_deadlines;
+    double m_total_jitter;
+    double m_max_jitter;
+};
+
+/** Blocking call that waits for the next frame of animation. Uses a
+ *  FramePacer which is private to the calling thread.
  * 
  *  \param frames_per_second the target frame rate
  */
 void next_frame(float frames_per_second = 30.0f);
 
+/** The FramePacer used by next_frame() on the calling thread */
+FramePacer &frame_pacer();
+
+/** The durations of one phase of drawing, in seconds */
+struct PhaseStats
+{
+    /** The number of times the phase was timed */
+    std::uint64_t count;
+
+    /** The total time spent in the phase */
+    double total;
+
+    /** The longest single occurrence of the phase */
+    double max;
+
+    /** The most recent occurrence of the phase */
+    double last;
+};
+
+/** Performance counters shared by all grids and the render thread. The
+ *  counts are always kept; the phases are only timed while timing is
+ *  enabled with set_timing_enabled().
+ */
+struct RenderStats
+{
+    /** The number of frames passed to TextGrid::blit() */
+    std::uint64_t frames_blitted;
+
+    /** The number of blitted frames picked up and drawn by a backend */
+    std::uint64_t frames_presented;
+
+    /** The number of blitted frames replaced by a newer one before they were drawn */
+    std::uint64_t frames_dropped;
+
+    /** The number of blitted frames left out of a recording because it was
+     *  being written too slowly. Their changes are recorded with the next frame.
+     */
+    std::uint64_t frames_not_recorded;
+
+    /** The number of cells in the regions modified by drawing calls */
+    std::uint64_t cells_drawn;
+
+    /** Time spent by drawing calls waiting for a grid which another thread
+     *  held. Uncontended locks are not timed.
+     */
+    PhaseStats lock_wait;
+
+    /** Time spent in TextGrid::blit() publishing frames */
+    PhaseStats blit;
+
+    /** Time the backends spent drawing each frame, including presenting it */
+    PhaseStats draw_rows;
+
+    /** Time spent handing drawn frames to the display, e.g. swapping buffers */
+    PhaseStats present;
+
+    /** Time the render thread spent in each pass over the grids and events */
+    PhaseStats update;
+
+    /** Time the render thread spent waiting for work */
+    PhaseStats idle;
+
+    /** How late FramePacer::wait() and next_frame() returned after their deadlines */
+    PhaseStats oversleep;
+};
+
+/** The performance counters gathered since the program started or the last
+ *  call to reset_render_stats().
+ */
+RenderStats render_stats();
+
+/** Clears the performance counters */
+void reset_render_stats();
+
+/** Turns the timing of the phases in RenderStats on or off. Timing is off by
+ *  default, in which case the instrumentation costs at most a relaxed atomic
+ *  add per call.
+ *
+ *  \param enabled whether phases should be timed
+ */
+void set_timing_enabled(bool enabled);
+
+/** Whether the phases in RenderStats are being timed */
+bool is_timing_enabled();
+
 
 /** Fix the range of a value to fall within the range [min, max].
  * 
@@ -289,16 +667,355 @@ private:
     Color m_color;
 };
 
-/** Class representing a row of character in the grid */
-class Row : public std::vector<Letter>
+/** Compact representation of a single cell in a grid: an ASCII value and
+ *  a handle into the color palette of the owning grid.
+ */
+struct Cell
+{
+    char value;
+    ColorHandle color;
+};
+
+/** Contiguous, cache-aligned storage for the cells of a grid */
+typedef std::vector<Cell, CacheAlignedAllocator<Cell>> CellBuffer;
+
+/** A vertical scroll of whole rows made by TextGrid::scroll(). Anything which
+ *  holds an earlier copy of the grid can bring it up to date by moving its
+ *  own rows in the same way, rather than by redrawing them.
+ */
+struct RowShift
+{
+    /** The grid version in which the rows were moved */
+    std::uint64_t version;
+
+    /** The first row of the scrolled region */
+    Index top;
+
+    /** One past the last row of the scrolled region */
+    Index bottom;
+
+    /** The number of rows moved down, or up if negative */
+    Index rows;
+};
+
+/** Class representing a read-only view of a row of characters in the grid.
+ *  The view is only valid until the grid is next modified.
+ */
+class Row
 {
 public:
     /** Constructor.
      *
+     *  \param cells pointer to the first cell of the row
      *  \param cols the number of columns in the row
-     *  \param color the default color to use (if none is specified)
+     *  \param palette the palette used to resolve the cell colors
+     */
+    Row(const Cell *cells, Size cols, const std::vector<Color> &palette);
+
+    /** The number of columns in the row */
+    Size size() const;
+
+    /** Get the ASCII value and color at the specified column.
+     *
+     *  \param col must be a valid column index in the range [0, size)
+     *  \return the letter at this column
+     */
+    Letter operator[](Size col) const;
+
+    /** The raw cells of the row */
+    const Cell *cells() const;
+
+private:
+    const Cell *m_cells;
+    Size m_cols;
+    const std::vector<Color> *m_palette;
+};
+
+/** Class representing a pre-built block of letters which can be drawn into a
+ *  grid in one call, e.g. a multi-line character or piece of scenery. Cells
+ *  can be transparent, in which case the grid shows through them. The opaque
+ *  cells of each row are stored as runs, so drawing a sprite is a sequence of
+ *  clipped copies with no per-cell tests and no allocation.
+ */
+class Sprite
+{
+public:
+    /** Constructor. Letters drawn from a string use the color mappings of the
+     *  grid they are drawn into, as with TextGrid::draw(Index, Index, const std::string &).
+     *
+     *  \param lines the rows of the sprite, from top to bottom. Shorter lines
+     *               are padded with transparent cells.
+     *  \param transparent the value which marks a transparent cell
+     */
+    Sprite(const std::vector<std::string> &lines, char transparent = ' ');
+
+    /** Constructor. Letters fully define their values and colors.
+     *
+     *  \param letters the rows of the sprite, from top to bottom. Shorter rows
+     *                 are padded with transparent cells.
+     *  \param transparent the value which marks a transparent cell
+     */
+    Sprite(const std::vector<std::vector<Letter>> &letters, char transparent = ' ');
+
+    /** The number of rows in the sprite */
+    Size rows() const;
+
+    /** The number of columns in the sprite */
+    Size cols() const;
+
+    /** Whether a cell is drawn, or lets the grid show through.
+     *
+     *  \param row must be in the range [0, rows)
+     *  \param col must be in the range [0, cols)
+     *  \return whether the cell is opaque
+     */
+    bool is_opaque(Size row, Size col) const;
+
+    friend class TextGrid;
+
+private:
+    /** A horizontal run of opaque cells */
+    struct Run
+    {
+        Size row;
+        Size col;
+        Size length;
+        std::size_t offset;
+    };
+
+    /** Marks a cell which takes the color mapped to its value by the grid */
+    static const ColorHandle MAPPED = 0xFFFF;
+
+    void add_row(Size row, const Cell *cells, Size count, char transparent);
+
+    Size m_rows;
+    Size m_cols;
+    std::vector<Color> m_palette;
+    std::vector<Cell> m_cells;
+    std::vector<Run> m_runs;
+};
+
+/** Class which collects a sequence of drawing commands, so that they can be
+ *  applied to a TextGrid in one pass while it is locked once with
+ *  TextGrid::apply(). The commands behave exactly as the TextGrid methods
+ *  of the same name, and are applied in the order they were added. A batch
+ *  can be applied any number of times, and reused after reset().
+ */
+class DrawBatch
+{
+public:
+    /** Adds a command which draws a string of characters.
+     *
+     *  \param row the row to use for writing
+     *  \param col the column to start writing at
+     *  \param values the values to draw
+     *
+     *  \sa TextGrid::draw(Index, Index, const std::string &)
+     */
+    DrawBatch &draw(Index row, Index col, const std::string &values);
+
+    /** Adds a command which draws a string of letters.
+     *
+     *  \param row the row to use for writing
+     *  \param col the column to start writing at
+     *  \param letters the values and colors to draw
+     *
+     *  \sa TextGrid::draw(Index, Index, const std::vector<Letter> &)
+     */
+    DrawBatch &draw(Index row, Index col, const std::vector<Letter> &letters);
+
+    /** Adds a command which fills a rectangular area.
+     *
+     *  \param rect the area to fill
+     *  \param value the ASCII value to use when filling
+     *
+     *  \sa TextGrid::draw(const Rect &, char)
+     */
+    DrawBatch &draw(const Rect &rect, char value);
+
+    /** Adds a command which clears a region of a row.
+     *
+     *  \param row the row to clear
+     *  \param col the starting column
+     *  \param cols the number of columns to clear
+     *
+     *  \sa TextGrid::clear(Index, Index, Size)
+     */
+    DrawBatch &clear(Index row, Index col, Size cols);
+
+    /** Adds a command which clears a rectangular region.
+     *
+     *  \param rect the region
+     *
+     *  \sa TextGrid::clear(const Rect &)
+     */
+    DrawBatch &clear(const Rect &rect);
+
+    /** Adds a command which draws a sprite. The sprite is not copied, and must
+     *  not be destroyed or modified while the batch is in use.
+     *
+     *  \param sprite the sprite to draw
+     *  \param row the row of the top of the sprite
+     *  \param col the column of the left of the sprite
+     *
+     *  \sa TextGrid::blit_sprite
+     */
+    DrawBatch &blit_sprite(const Sprite &sprite, Index row, Index col);
+
+    /** Removes all of the commands, keeping the memory allocated for them */
+    void reset();
+
+    /** The number of commands in the batch */
+    std::size_t size() const;
+
+    friend class TextGrid;
+    friend class DrawQueue;
+
+private:
+    enum class Op
+    {
+        TEXT,
+        LETTERS,
+        FILL,
+        CLEAR,
+        SPRITE
+    };
+
+    struct Command
+    {
+        Op op;
+        char value;
+        Index row;
+        Index col;
+        Size width;
+        Size height;
+        std::size_t offset;
+        std::size_t count;
+    };
+
+    std::vector<Command> m_commands;
+    std::string m_text;
+    std::vector<Letter> m_letters;
+    std::vector<const Sprite *> m_sprites;
+};
+
+/** What a DrawQueue does with a command added while it is full */
+enum class BackPressure
+{
+    /** The producer waits until a command has been applied */
+    BLOCK,
+
+    /** The oldest pending command is discarded to make room */
+    DROP_OLDEST,
+
+    /** The command replaces the newest pending one which covers exactly the
+     *  same cells, e.g. an earlier value of the same field, as long as no
+     *  command added after that one draws to any of those cells. Otherwise
+     *  the oldest pending command is discarded.
+     */
+    COALESCE
+};
+
+/** Class which lets any number of threads send drawing commands to a
+ *  TextGrid without taking its lock. Adding a command only copies it into a
+ *  free slot of a fixed ring, and the commands are applied in bulk, in the
+ *  order they were added, by TextGrid::apply() or by every TextGrid::blit()
+ *  once the queue has been attached with TextGrid::set_draw_queue(). The
+ *  commands behave exactly as the TextGrid methods of the same name.
+ *
+ *  Slots keep the memory of the largest command copied into them, so once
+ *  the queue is warm adding a command does not allocate.
+ */
+class DrawQueue
+{
+public:
+    /** Constructor.
+     *
+     *  \param capacity the number of commands which can be pending, rounded
+     *                  up to a power of two
+     *  \param back_pressure what to do with commands added while the queue
+     *                       is full
+     */
+    DrawQueue(std::size_t capacity = 4096, BackPressure back_pressure = BackPressure::BLOCK);
+
+    DrawQueue(const DrawQueue &) = delete;
+    DrawQueue &operator=(const DrawQueue &) = delete;
+
+    /** Adds a command which draws a string of characters.
+     *
+     *  \sa TextGrid::draw(Index, Index, const std::string &)
+     */
+    DrawQueue &draw(Index row, Index col, const std::string &values);
+
+    /** Adds a command which draws a string of letters.
+     *
+     *  \sa TextGrid::draw(Index, Index, const std::vector<Letter> &)
+     */
+    DrawQueue &draw(Index row, Index col, const std::vector<Letter> &letters);
+
+    /** Adds a command which fills a rectangular area.
+     *
+     *  \sa TextGrid::draw(const Rect &, char)
+     */
+    DrawQueue &draw(const Rect &rect, char value);
+
+    /** Adds a command which clears a region of a row.
+     *
+     *  \sa TextGrid::clear(Index, Index, Size)
+     */
+    DrawQueue &clear(Index row, Index col, Size cols);
+
+    /** Adds a command which clears a rectangular region.
+     *
+     *  \sa TextGrid::clear(const Rect &)
+     */
+    DrawQueue &clear(const Rect &rect);
+
+    /** The number of commands which can be pending */
+    std::size_t capacity() const;
+
+    /** What is done with commands added while the queue is full */
+    BackPressure back_pressure() const;
+
+    /** The number of commands waiting to be applied. Only approximate while
+     *  commands are being added or applied.
+     */
+    std::size_t size() const;
+
+    /** The number of commands discarded because the queue was full */
+    std::uint64_t dropped() const;
+
+    /** The number of commands which replaced a pending command */
+    std::uint64_t coalesced() const;
+
+    friend class TextGrid;
+
+private:
+    /** A slot holds a command for position p once its sequence is p + 1, is
+     *  free for position p when it is p, and is held by whoever is reading
+     *  or replacing the command for position p when it is p again.
      */
-    Row(Size cols, const Color &color = Colors::White);
+    struct Slot
+    {
+        std::atomic<std::uint64_t> sequence;
+        DrawBatch::Command command;
+        std::string text;
+        std::vector<Letter> letters;
+    };
+
+    static void write(Slot &slot, const DrawBatch::Command &command, const char *text, const Letter *letters);
+    void push(const DrawBatch::Command &command, const char *text, const Letter *letters);
+    bool coalesce(const DrawBatch::Command &command, const char *text, const Letter *letters);
+    Slot *claim();
+    void release(Slot *slot);
+
+    const std::size_t m_capacity;
+    const BackPressure m_back_pressure;
+    std::unique_ptr<Slot[]> m_slots;
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> m_head;
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> m_tail;
+    std::atomic<std::uint64_t> m_dropped;
+    std::atomic<std::uint64_t> m_coalesced;
 };
 
 /** Class representing a grid of animated ASCII text */
@@ -308,6 +1025,9 @@ public:
     /** Move constructor. */
     TextGrid(TextGrid &&other);
 
+    /** Destructor. */
+    ~TextGrid();
+
     /** Maps an ASCII value to have a alternate default color. This will be
      *  used for that character if no other color is specified.
      * 
@@ -322,6 +1042,14 @@ public:
      */
     TextGrid &unmap_color(char value);
 
+    /** Sets the color of every cell in a region to the one currently mapped
+     *  to its ASCII value, e.g. after changing the mappings, without drawing
+     *  the text again.
+     *
+     *  \param rect the region to recolor
+     */
+    TextGrid &recolor(const Rect &rect);
+
     /** Draw a string of character at the specified row and column. The
      *  text will be truncated on the right or the left if needed.
      * 
@@ -365,20 +1093,84 @@ public:
      */
     TextGrid &clear(const Rect &rect);
 
+    /** Draws a sprite with its top-left corner at the specified row and
+     *  column. The sprite is clipped to the grid, and its transparent cells
+     *  leave the grid unchanged.
+     *
+     *  \param sprite the sprite to draw
+     *  \param row the row of the top of the sprite. Can be any value.
+     *  \param col the column of the left of the sprite. Can be any value.
+     */
+    TextGrid &blit_sprite(const Sprite &sprite, Index row, Index col);
+
+    /** Applies all of the commands in a batch, in order, while holding the
+     *  lock on the grid once rather than once per command.
+     *
+     *  \param batch the commands to apply
+     */
+    TextGrid &apply(const DrawBatch &batch);
+
+    /** Applies every command waiting in a queue, in order, while holding the
+     *  lock on the grid once. Commands added while this runs may be left for
+     *  the next call.
+     *
+     *  \param queue the commands to apply
+     */
+    TextGrid &apply(DrawQueue &queue);
+
+    /** Attaches a queue whose pending commands are applied at the start of
+     *  every blit(), so that producer threads only ever add to the queue and
+     *  the grid is locked once per frame. Pass nullptr to detach it.
+     *
+     *  \param queue the queue to attach
+     */
+    void set_draw_queue(const std::shared_ptr<DrawQueue> &queue);
+
+    /** Moves the contents of a rectangular region, e.g. to scroll a log up
+     *  by a line when a new one arrives. Cells moved out of the region are
+     *  discarded, and the cells they leave behind are cleared. Scrolling
+     *  whole rows vertically only reorders the rows rather than copying
+     *  them, and the renderers move what they have already drawn instead
+     *  of redrawing it.
+     *
+     *  \param rect the region to scroll
+     *  \param rows the number of rows to move down, or up if negative
+     *  \param cols the number of columns to move right, or left if negative
+     */
+    TextGrid &scroll(const Rect &rect, Index rows, Index cols = 0);
+
+    /** Adds a layer on top of the grid and any existing layers. The grid is
+     *  shown as the composite of its layers: each cell shows the topmost
+     *  layer which is opaque there, or the grid itself if none are. Only the
+     *  cells which were drawn to since the last blit() are recomposited, so
+     *  layers which do not change cost nothing per frame. The methods of the
+     *  grid itself, including get_letter() and CellLock, act on the bottom
+     *  plane beneath all of the layers.
+     *
+     *  \return the new layer, which is fully transparent
+     */
+    std::shared_ptr<Layer> add_layer();
+
+    /** Removes a layer from the grid. The layer can no longer be drawn to.
+     *
+     *  \param layer a layer added to this grid
+     */
+    void remove_layer(const std::shared_ptr<Layer> &layer);
+
     /** Get the ASCII value and color at the specified index.
      *  
      *  \param row the desired row
      *  \param column the desired column
      *  \return the letter at this index
      */
-    const Letter &get_letter(Index row, Index col) const;
+    Letter get_letter(Index row, Index col) const;
 
     /** Get the desired Row.
      * 
      *  \param row must be a valid row index in the range [0, rows]
-     *  \return a reference to the row
+     *  \return a view of the row
      */
-    const Row &get_row(Index row) const;
+    Row get_row(Index row) const;
 
     /** The number of rows in the grid */
     Size rows() const;
@@ -398,12 +1190,46 @@ public:
     /** Represents of the state of the object as a string */
     std::string to_string() const;
 
-    /** Requests that the TextGrid be redrawn to the screen */
+    /** Requests that the TextGrid be redrawn to the screen. Drawing calls
+     *  modify a back buffer which is private to the application; this
+     *  publishes a consistent snapshot of it to the render thread without
+     *  waiting for rendering to finish. If the render thread has not yet
+     *  picked up the previous snapshot it is replaced, i.e. the latest
+     *  frame always wins.
+     */
     void blit();
 
+    /** Starts recording every frame passed to blit() into a compact binary
+     *  file, replacing any recording already in progress. The file holds
+     *  periodic keyframes and, between them, only the runs of cells which
+     *  changed in each frame. Encoding and writing happen on a background
+     *  thread, so blit() only has to copy the rows which changed.
+     *
+     *  Throws std::runtime_error if the replaced recording could not be
+     *  written.
+     *
+     *  \param path the path of the file to write
+     *  \param keyframe_interval the number of frames between keyframes
+     */
+    void start_recording(const std::string &path, std::uint32_t keyframe_interval = 300);
+
+    /** Stops recording, waiting until all recorded frames have been written.
+     *  Throws std::runtime_error if any part of the recording could not be
+     *  written, e.g. because the disk is full.
+     */
+    void stop_recording();
+
+    /** Whether blitted frames are being recorded */
+    bool is_recording() const;
+
     friend std::shared_ptr<TextGrid> create_grid(Size, Size, const std::string &, const Color &);
-    friend void display_grid();
-    friend void refresh_grids();
+    friend class GlBackend;
+    friend class HeadlessBackend;
+    friend class TerminalBackend;
+    friend class ReplayPlayer;
+    friend class CellLock;
+    friend class Camera;
+    friend class Layer;
 
 protected:
     /** Constructor. Protected due to the need for the factory to manage creation
@@ -411,23 +1237,663 @@ protected:
      */
     TextGrid(Size rows, Size cols, const std::string &title, const Color &default_color);
 
-    /** Draws the rows of this TextGrid to the current in-context GL window. */
-    void draw_rows();
+    /** Draws the most recently blitted frame of this TextGrid. Calls must not
+     *  overlap, and are normally made from the render thread.
+     *
+     *  \param renderer the renderer associated with the display surface
+     */
+    void draw_rows(FrameRenderer &renderer);
 
-    /** Whether the text grid needs to be redrawn */
+    /** Whether a frame has been blitted which has not yet been drawn */
     bool is_dirty();
 
 private:
-    const Color &get_color(char value) const;
-    std::vector<Row> m_grid;
-    std::map<char, Color> m_color_map;
+    /** A snapshot of the grid published by blit() */
+    struct Frame
+    {
+        CellBuffer cells;
+        std::vector<Color> palette;
+        std::uint64_t palette_version;
+        std::vector<std::uint64_t> row_versions;
+        std::uint64_t version;
+        std::vector<RowShift> shifts;
+        std::uint64_t shift_floor;
+    };
+
+    static const std::uint32_t FRESH_FRAME = 0x4;
+    static const std::uint32_t FRAME_INDEX_MASK = 0x3;
+
+    void draw_text(Cell *plane, Index row, Index col, const char *values, std::size_t count);
+    void draw_letters(Cell *plane, Index row, Index col, const Letter *letters, std::size_t count);
+    void fill(Cell *plane, const Rect &rect, const Cell &cell);
+    void clear_cells(Cell *plane, Index row, Index col, Size cols, const Cell &blank);
+    void draw_sprite(Cell *plane, const Sprite &sprite, Index row, Index col);
+    void apply_batch(Cell *plane, const DrawBatch &batch, const Cell &blank);
+    void apply_command(Cell *plane, const DrawBatch::Command &command, const char *text, const Letter *letters,
+                       const Sprite *sprite, const Cell &blank);
+    void apply_queue(DrawQueue &queue);
+    std::unique_lock<std::mutex> lock_rows();
+    void recolor_cells(Cell *plane, const Rect &rect);
+    void scroll_cells(Cell *plane, const Rect &rect, Index rows, Index cols, const Cell &blank);
+    void scroll_rows(Index top, Index bottom, Index rows);
+    void normalize_rows();
+    ColorHandle get_color(char value) const;
+    ColorHandle intern_color(const Color &color);
+    void intern_colors(const std::vector<Color> &colors, std::vector<ColorHandle> &handles);
+    void damage(Index first_row, Index last_row);
+    void damage(Index first_row, Index last_row, Index left, Index right);
+    void compose();
+    void compact_palette();
+    Cell *row_cells(Index row);
+    const Cell *row_cells(Index row) const;
+    Cell *row_cells(Cell *plane, Index row) const;
+    const Cell *presented_row(Index row) const;
+    FrameView view(const Frame &frame) const;
+    CellBuffer m_cells;
+    std::vector<Size> m_row_slots;
+    std::vector<std::shared_ptr<Layer>> m_layers;
+    CellBuffer m_composite;
+    std::vector<Index> m_compose_left;
+    std::vector<Index> m_compose_right;
+    std::vector<Color> m_palette;
+    std::unordered_map<std::uint32_t, ColorHandle> m_palette_index;
+    std::array<ColorHandle, 256> m_color_table;
     Color m_default_color;
+    ColorHandle m_default_handle;
     const Size m_rows;
     const Size m_cols;
     const std::string m_title;
-    bool m_is_dirty;
+    std::uint64_t m_palette_version;
+    std::vector<std::uint64_t> m_row_versions;
+    std::uint64_t m_version;
+    std::vector<RowShift> m_shifts;
+    std::uint64_t m_shift_floor;
+    Frame m_frames[3];
+    std::uint32_t m_back_frame;
+    std::uint32_t m_front_frame;
+    std::atomic<std::uint32_t> m_ready_frame;
+    std::unique_ptr<FrameRecorder> m_recorder;
+    std::atomic<bool> m_is_recording;
+    std::shared_ptr<DrawQueue> m_draw_queue;
+    std::vector<ColorHandle> m_sprite_handles;
     int m_id;
+    const std::uint64_t m_serial;
     std::mutex m_rows_mutex;
+    bool m_is_checked_out;
+    std::condition_variable m_cells_returned;
+};
+
+/** Class representing one of the planes of a TextGrid, created with
+ *  TextGrid::add_layer(). A layer starts out transparent, and the cells
+ *  drawn to it cover the layers beneath until they are cleared. Its drawing
+ *  methods behave exactly as the TextGrid methods of the same name, except
+ *  that clearing a cell makes it transparent rather than blank.
+ */
+class Layer
+{
+public:
+    /** Draw a string of characters at the specified row and column.
+     *
+     *  \sa TextGrid::draw(Index, Index, const std::string &)
+     */
+    Layer &draw(Index row, Index col, const std::string &values);
+
+    /** Draw a string of letters at the specified row and column.
+     *
+     *  \sa TextGrid::draw(Index, Index, const std::vector<Letter> &)
+     */
+    Layer &draw(Index row, Index col, const std::vector<Letter> &letters);
+
+    /** Fills a rectangular area with the specified value.
+     *
+     *  \sa TextGrid::draw(const Rect &, char)
+     */
+    Layer &draw(const Rect &rect, char value);
+
+    /** Makes a region of the specified row transparent.
+     *
+     *  \param row the row to clear
+     *  \param col the starting column. Can be any value, and the region
+     *             will be clipped appropriately
+     *  \param cols the number of columns to clear
+     */
+    Layer &clear(Index row, Index col, Size cols);
+
+    /** Makes a rectangular region transparent.
+     *
+     *  \param rect the region
+     */
+    Layer &clear(const Rect &rect);
+
+    /** Makes the whole layer transparent */
+    Layer &clear();
+
+    /** Sets the color of every opaque cell in a region to the one mapped to
+     *  its ASCII value by the grid.
+     *
+     *  \sa TextGrid::recolor
+     */
+    Layer &recolor(const Rect &rect);
+
+    /** Moves the contents of a rectangular region, leaving transparent cells
+     *  behind.
+     *
+     *  \sa TextGrid::scroll
+     */
+    Layer &scroll(const Rect &rect, Index rows, Index cols = 0);
+
+    /** Draws a sprite with its top-left corner at the specified row and column.
+     *
+     *  \sa TextGrid::blit_sprite
+     */
+    Layer &blit_sprite(const Sprite &sprite, Index row, Index col);
+
+    /** Applies all of the commands in a batch to the layer.
+     *
+     *  \sa TextGrid::apply
+     */
+    Layer &apply(const DrawBatch &batch);
+
+    /** Whether the layer still belongs to a grid */
+    bool is_attached() const;
+
+    friend class TextGrid;
+
+private:
+    /** The value of a transparent cell */
+    static const char TRANSPARENT = '\0';
+
+    Layer(TextGrid *text_grid);
+    TextGrid &attached() const;
+
+    TextGrid *m_text_grid;
+    CellBuffer m_cells;
+};
+
+/** Class which gives direct access to the cells of a TextGrid, e.g. to update
+ *  a whole frame with bulk copies. The grid is locked for as long as the
+ *  object holds it, so other drawing calls on the grid wait until it is
+ *  released. On release the modified rows are marked for redrawing; they
+ *  are shown once the grid is next blitted.
+ */
+class CellLock
+{
+public:
+    /** Constructor. Locks the grid.
+     *
+     *  \param text_grid the grid to access
+     */
+    CellLock(TextGrid &text_grid);
+
+    /** Destructor. Releases the grid if it is still held. */
+    ~CellLock();
+
+    CellLock(const CellLock &) = delete;
+    CellLock &operator=(const CellLock &) = delete;
+
+    /** The cells of the grid in row-major order. Must not be used after release(). */
+    Cell *cells();
+
+    /** The number of rows in the grid */
+    Size rows() const;
+
+    /** The number of columns in the grid */
+    Size cols() const;
+
+    /** Returns the palette handle to use in cells for a color, adding it to the
+     *  palette of the grid if needed. If the palette is full, unused entries
+     *  are removed and the handles already stored in cells are remapped.
+     *
+     *  \param color the color
+     *  \return the handle of the color
+     */
+    ColorHandle color_handle(const Color &color);
+
+    /** Marks rows as modified. If this is never called, every row is treated
+     *  as modified when the grid is released.
+     *
+     *  \param first_row the first modified row
+     *  \param last_row one past the last modified row
+     */
+    void damage(Index first_row, Index last_row);
+
+    /** Marks the modified rows for redrawing and unlocks the grid. May be
+     *  called from any thread.
+     */
+    void release();
+
+    /** Whether the grid is still held */
+    bool is_locked() const;
+
+private:
+    TextGrid *m_text_grid;
+    std::atomic<bool> m_is_locked;
+    bool m_has_damage;
+};
+
+/** Class which plays back a recording made with TextGrid::start_recording().
+ *  The file is memory-mapped rather than read, so opening even a very long
+ *  recording is immediate, and only the current frame is held in memory.
+ *  Recordings can be sought to any keyframe in constant time, and to any
+ *  other frame by decoding forward from the keyframe before it.
+ */
+class ReplayPlayer
+{
+public:
+    /** Constructor. Throws std::runtime_error if the file is not a recording.
+     *
+     *  \param path the path of the recording
+     */
+    ReplayPlayer(const std::string &path);
+
+    /** Destructor. */
+    ~ReplayPlayer();
+
+    /** The number of rows in the recorded grid */
+    Size rows() const;
+
+    /** The number of columns in the recorded grid */
+    Size cols() const;
+
+    /** The number of frames in the recording */
+    std::uint32_t frames() const;
+
+    /** The number of keyframes in the recording */
+    std::uint32_t keyframes() const;
+
+    /** The number of the current frame */
+    std::uint32_t frame() const;
+
+    /** The position of playback, in seconds from the first frame */
+    double time() const;
+
+    /** The time of the last frame, in seconds from the first frame */
+    double duration() const;
+
+    /** Whether the last frame has been reached */
+    bool is_finished() const;
+
+    /** Moves to a keyframe.
+     *
+     *  \param keyframe the index of the keyframe, in the range [0, keyframes)
+     */
+    void seek_keyframe(std::uint32_t keyframe);
+
+    /** Moves to a frame.
+     *
+     *  \param frame the frame number, in the range [0, frames)
+     */
+    void seek(std::uint32_t frame);
+
+    /** Moves to the next frame.
+     *
+     *  \return whether there was another frame
+     */
+    bool step();
+
+    /** Advances playback by an amount of recorded time, moving past every
+     *  frame recorded in that interval. Scaling the interval by a factor
+     *  plays back faster or slower than the recording was made.
+     *
+     *  \param seconds the time to advance by
+     *  \return the number of frames moved past
+     */
+    std::uint32_t advance(double seconds);
+
+    /** Draws the current frame into a grid. Cells outside the grid are ignored,
+     *  and only the rows which have changed since the frame was last drawn
+     *  into the same grid are copied. The grid is not blitted.
+     *
+     *  \param text_grid the grid to draw into
+     */
+    void show(TextGrid &text_grid);
+
+    /** Blocking call which plays the rest of the recording into a grid,
+     *  blitting one frame of the grid per call to next_frame().
+     *
+     *  \param text_grid the grid to draw into
+     *  \param frames_per_second the rate at which the grid is blitted
+     *  \param speed the rate of playback relative to the recording
+     */
+    void play(const std::shared_ptr<TextGrid> &text_grid, float frames_per_second = 30.0f, float speed = 1.0f);
+
+private:
+    /** The location of a keyframe in the file */
+    struct Keyframe
+    {
+        std::uint32_t frame;
+        std::uint64_t time;
+        std::uint64_t offset;
+    };
+
+    bool read_index();
+    void scan_index();
+    bool peek_time(std::uint64_t &time) const;
+    bool read_frame();
+    std::size_t read_cells(std::size_t offset, Cell *cells, std::size_t count);
+
+    std::unique_ptr<MappedFile> m_file;
+    Size m_rows;
+    Size m_cols;
+    std::uint32_t m_frames;
+    std::uint64_t m_duration;
+    std::vector<Keyframe> m_keyframes;
+    std::size_t m_offset;
+    std::uint32_t m_frame;
+    std::uint64_t m_frame_time;
+    double m_time;
+    CellBuffer m_cells;
+    std::vector<Color> m_palette;
+    std::vector<bool> m_changed;
+    bool m_palette_changed;
+    std::uint64_t m_last_grid;
+    std::uint64_t m_grid_palette_version;
+    std::vector<ColorHandle> m_handles;
+};
+
+/** The number of rows and of columns in each chunk of a WorldGrid */
+const std::int32_t WORLD_CHUNK_SIZE = 64;
+
+/** Class representing a world of cells far larger than a TextGrid, addressed
+ *  by 32-bit rows and columns which may be negative. Cells are stored in
+ *  square chunks which are only allocated once something other than a blank
+ *  is drawn in them, so memory scales with the area which has been drawn
+ *  rather than with the extent of the world. The world is shown through a
+ *  Camera. All methods may be called from any thread.
+ */
+class WorldGrid
+{
+public:
+    /** Constructor.
+     *
+     *  \param default_color the color of blank cells, and of strings drawn
+     *                       without colors
+     */
+    WorldGrid(const Color &default_color = Colors::White);
+
+    /** Draw a string of characters in the default color.
+     *
+     *  \param row the row of the first character
+     *  \param col the column of the first character
+     *  \param values the characters to draw
+     */
+    WorldGrid &draw(std::int32_t row, std::int32_t col, const std::string &values);
+
+    /** Draw a string of letters.
+     *
+     *  \param row the row of the first letter
+     *  \param col the column of the first letter
+     *  \param letters the letters to draw
+     */
+    WorldGrid &draw(std::int32_t row, std::int32_t col, const std::vector<Letter> &letters);
+
+    /** Fills a region with the specified value in the default color.
+     *
+     *  \param top the first row of the region
+     *  \param left the first column of the region
+     *  \param rows the number of rows in the region
+     *  \param cols the number of columns in the region
+     *  \param value the value to fill with
+     */
+    WorldGrid &fill(std::int32_t top, std::int32_t left, std::int32_t rows, std::int32_t cols, char value);
+
+    /** Clears a region, freeing any chunks which it covers entirely.
+     *
+     *  \param top the first row of the region
+     *  \param left the first column of the region
+     *  \param rows the number of rows in the region
+     *  \param cols the number of columns in the region
+     */
+    WorldGrid &clear(std::int32_t top, std::int32_t left, std::int32_t rows, std::int32_t cols);
+
+    /** Clears the whole world, freeing every chunk */
+    WorldGrid &clear();
+
+    /** Get the ASCII value and color at the specified cell.
+     *
+     *  \param row the desired row
+     *  \param col the desired column
+     *  
+     *  \return the letter at this cell
+     */
+    Letter get_letter(std::int32_t row, std::int32_t col) const;
+
+    /** The number of chunks which have been allocated */
+    std::size_t chunk_count() const;
+
+    friend class Camera;
+    friend class MapStreamer;
+
+private:
+    struct Chunk
+    {
+        Cell cells[WORLD_CHUNK_SIZE * WORLD_CHUNK_SIZE];
+
+        /** Whether the chunk has been drawn to, as opposed to only loaded */
+        bool is_modified = false;
+    };
+
+    static std::uint64_t chunk_key(std::int32_t chunk_row, std::int32_t chunk_col);
+    ColorHandle intern_color(const Color &color);
+    const Cell *find_row(std::int32_t row, std::int32_t col) const;
+    Cell *row_span(std::int32_t row, std::int32_t col);
+    void draw_cells(std::int32_t row, std::int32_t col, const Cell *cells, std::size_t count);
+    void fill_cells(std::int32_t top, std::int32_t left, std::int32_t rows, std::int32_t cols, const Cell &cell);
+
+    std::unordered_map<std::uint64_t, std::unique_ptr<Chunk>> m_chunks;
+    std::vector<Color> m_palette;
+    std::unordered_map<std::uint32_t, ColorHandle> m_palette_index;
+    std::vector<Cell> m_scratch;
+    mutable std::mutex m_mutex;
+};
+
+/** Class which shows the part of a WorldGrid under a window the size of a
+ *  TextGrid. Each call to draw() copies only the visible cells, so its cost
+ *  depends on the size of the grid and not of the world, and only the rows
+ *  which changed are redrawn by the backend.
+ */
+class Camera
+{
+public:
+    /** Constructor. The camera starts with its top-left corner at (0, 0).
+     *
+     *  \param world the world to show
+     *  \param text_grid the grid to show it in
+     */
+    Camera(const std::shared_ptr<WorldGrid> &world, const std::shared_ptr<TextGrid> &text_grid);
+
+    /** Moves the top-left corner of the camera to a cell of the world.
+     *
+     *  \param row the row of the world shown in the first row of the grid
+     *  \param col the column of the world shown in the first column of the grid
+     */
+    Camera &move_to(std::int32_t row, std::int32_t col);
+
+    /** Moves the camera by an offset.
+     *
+     *  \param rows the number of rows to move down by
+     *  \param cols the number of columns to move right by
+     */
+    Camera &move_by(std::int32_t rows, std::int32_t cols);
+
+    /** Moves the camera so that a cell of the world is in the middle of the grid.
+     *
+     *  \param row the row of the cell
+     *  \param col the column of the cell
+     */
+    Camera &center_on(std::int32_t row, std::int32_t col);
+
+    /** The row of the world shown in the first row of the grid */
+    std::int32_t row() const;
+
+    /** The column of the world shown in the first column of the grid */
+    std::int32_t col() const;
+
+    /** The number of rows of the world which are shown */
+    Size rows() const;
+
+    /** The number of columns of the world which are shown */
+    Size cols() const;
+
+    /** Copies the visible part of the world into the grid. The grid is not
+     *  blitted.
+     */
+    void draw();
+
+private:
+    std::shared_ptr<WorldGrid> m_world;
+    std::shared_ptr<TextGrid> m_text_grid;
+    std::int32_t m_row;
+    std::int32_t m_col;
+    std::vector<ColorHandle> m_handles;
+    std::uint64_t m_grid_palette_version;
+};
+
+/** Class which converts a map into the tiled file format read by
+ *  MapStreamer. The map is written one row at a time from top to bottom,
+ *  and only one band of tiles is held in memory, so maps far larger than
+ *  memory can be converted.
+ */
+class TileMapWriter
+{
+public:
+    /** Constructor. Throws std::runtime_error if the file cannot be created.
+     *
+     *  \param path the path of the file to write
+     *  \param rows the number of rows in the map
+     *  \param cols the number of columns in the map
+     *  \param default_color the color of blank cells, and of rows written
+     *                       without colors
+     */
+    TileMapWriter(const std::string &path, std::uint32_t rows, std::uint32_t cols,
+                  const Color &default_color = Colors::White);
+
+    /** Destructor. Closes the file if close() has not been called. */
+    ~TileMapWriter();
+
+    TileMapWriter(const TileMapWriter &) = delete;
+    TileMapWriter &operator=(const TileMapWriter &) = delete;
+
+    /** Writes the next row of the map in the default color. Values past the
+     *  last column are ignored, and missing values are blank.
+     *
+     *  \param values the characters of the row
+     */
+    void write_row(const std::string &values);
+
+    /** Writes the next row of the map.
+     *
+     *  \param letters the letters of the row
+     */
+    void write_row(const std::vector<Letter> &letters);
+
+    /** Fills any rows not yet written with blanks and finishes the file */
+    void close();
+
+private:
+    Cell *next_row();
+    void flush_band();
+
+    std::ofstream m_file;
+    const std::uint32_t m_rows;
+    const std::uint32_t m_cols;
+    std::uint32_t m_row;
+    std::uint64_t m_offset;
+    CellBuffer m_band;
+    std::vector<std::uint64_t> m_index;
+    std::vector<Color> m_palette;
+    std::unordered_map<std::uint32_t, ColorHandle> m_palette_index;
+    std::vector<char> m_buffer;
+    bool m_is_open;
+};
+
+/** Class which streams a map written by TileMapWriter into a WorldGrid, with
+ *  the top-left corner of the map at row 0 and column 0 of the world. The
+ *  file is memory-mapped, and a background thread copies the tiles under
+ *  the view into the world, and those just beyond it in the direction the
+ *  view is moving, so the frame loop never waits for the disk. Tiles are
+ *  evicted from the world, least recently viewed first, once more than a
+ *  set number are loaded. A tile is never loaded over a chunk which is
+ *  already in the world, and chunks which have been drawn to are never
+ *  evicted, so anything the application draws in the map's area is kept,
+ *  at the cost of that chunk no longer being streamed.
+ */
+class MapStreamer
+{
+public:
+    /** Constructor. Throws std::runtime_error if the file is not a tile map.
+     *
+     *  \param path the path of the map
+     *  \param world the world to load tiles into
+     *  \param max_tiles the number of tiles to keep loaded. Tiles under the
+     *                   view are kept even beyond this number.
+     */
+    MapStreamer(const std::string &path, const std::shared_ptr<WorldGrid> &world, std::size_t max_tiles = 1024);
+
+    /** Destructor. Stops loading tiles. */
+    ~MapStreamer();
+
+    MapStreamer(const MapStreamer &) = delete;
+    MapStreamer &operator=(const MapStreamer &) = delete;
+
+    /** The number of rows in the map */
+    std::uint32_t rows() const;
+
+    /** The number of columns in the map */
+    std::uint32_t cols() const;
+
+    /** Moves the view, requesting the tiles under it and prefetching ahead of
+     *  it in the direction it moved since the last call. Never blocks on
+     *  loading; tiles which are not loaded yet are blank in the world.
+     *
+     *  \param top the first row of the view
+     *  \param left the first column of the view
+     *  \param rows the number of rows in the view
+     *  \param cols the number of columns in the view
+     */
+    void update(std::int32_t top, std::int32_t left, std::int32_t rows, std::int32_t cols);
+
+    /** Moves the view to the region shown by a camera.
+     *
+     *  \param camera the camera showing the world
+     */
+    void update(const Camera &camera);
+
+    /** Blocks until every requested tile has been loaded */
+    void wait();
+
+    /** The number of tiles loaded into the world */
+    std::size_t loaded_tiles() const;
+
+private:
+    void run();
+    void load(std::uint64_t key);
+    void request(std::int64_t first_row, std::int64_t last_row, std::int64_t first_col, std::int64_t last_col);
+    void evict();
+
+    std::unique_ptr<MappedFile> m_file;
+    std::shared_ptr<WorldGrid> m_world;
+    std::size_t m_max_tiles;
+    std::uint32_t m_rows;
+    std::uint32_t m_cols;
+    std::uint32_t m_tile_rows;
+    std::uint32_t m_tile_cols;
+    const char *m_index;
+    std::vector<ColorHandle> m_handles;
+    std::int32_t m_top;
+    std::int32_t m_left;
+    bool m_has_view;
+    std::deque<std::uint64_t> m_requests;
+    std::unordered_set<std::uint64_t> m_requested;
+    std::unordered_set<std::uint64_t> m_visible;
+    std::list<std::uint64_t> m_lru;
+    std::unordered_map<std::uint64_t, std::list<std::uint64_t>::iterator> m_loaded;
+    std::unordered_set<std::uint64_t> m_loading;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_work_ready;
+    std::condition_variable m_idle;
+    bool m_is_stopping;
+    std::thread m_thread;
 };
 
 std::ostream &operator<<(std::ostream &os, const Color &grid);
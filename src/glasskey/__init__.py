@@ -1,7 +1,13 @@
 """ glasskey module """
 
 from ._pyglasskey import init, start, stop, create_grid, destroy_grid, Color,\
-    next_frame, Letter, Rect, TextGrid, RowHeight, ColumnWidth, Key, is_pressed
+    next_frame, Letter, Rect, TextGrid, RowHeight, ColumnWidth, Key, is_pressed,\
+    FramePacer, FramePacerStats, frame_pacer, BackendType, set_backend, backend,\
+    Image, read_pixels, ReplayPlayer, DrawBatch, DrawQueue, BackPressure, CellLock,\
+    Sprite, Layer,\
+    PhaseStats, RenderStats, render_stats, reset_render_stats, set_timing_enabled,\
+    is_timing_enabled, KeyEvent, drain_key_events, dropped_key_events,\
+    WorldGrid, Camera, TileMapWriter, MapStreamer
 from . import _pyglasskey
 
 class Colors:
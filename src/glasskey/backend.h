@@ -0,0 +1,70 @@
+#ifndef _GK_BACKEND_H_
+#define _GK_BACKEND_H_
+
+#include "glasskey/glasskey.h"
+
+namespace gk
+{
+/** Interface for the systems which display grids and gather input. Apart
+ *  from init() and read_pixels(), methods are only called from the render
+ *  thread.
+ */
+class Backend
+{
+public:
+    virtual ~Backend() = default;
+
+    /** Initializes the backend.
+     *
+     *  \param args command line arguments for the underlying system
+     */
+    virtual void init(const std::vector<std::string> &args) = 0;
+
+    /** Creates the display surface for a grid and assigns the grid its id.
+     *
+     *  \param text_grid the grid to display
+     */
+    virtual void open(const std::shared_ptr<TextGrid> &text_grid) = 0;
+
+    /** Destroys the display surface of a grid.
+     *
+     *  \param text_grid the grid which is being destroyed
+     */
+    virtual void close(const std::shared_ptr<TextGrid> &text_grid) = 0;
+
+    /** Presents any newly blitted frames and processes pending events */
+    virtual void update() = 0;
+
+    /** Blocks until update() has work to do */
+    virtual void wait() = 0;
+
+    /** Reads back the most recently blitted frame of a grid as pixels.
+     *
+     *  \param text_grid the grid to read
+     *  \param image receives the pixels
+     *  \return whether reading back pixels is supported
+     */
+    virtual bool read_pixels(TextGrid & /*text_grid*/, Image & /*image*/)
+    {
+        return false;
+    }
+};
+
+/** Creates the backend which shows each grid in its own OpenGL window */
+std::unique_ptr<Backend> create_gl_backend();
+
+/** Creates the backend which rasterizes grids into in-memory images */
+std::unique_ptr<Backend> create_headless_backend();
+
+/** Creates the backend which draws grids as text on the terminal */
+std::unique_ptr<Backend> create_terminal_backend();
+
+/** Records a key being pressed or released. Called by backends on the
+ *  render thread as input arrives; no other thread may call it.
+ *
+ *  \param event the event. Its time is set to the current time.
+ */
+void add_key_event(KeyEvent event);
+} // namespace gk
+
+#endif
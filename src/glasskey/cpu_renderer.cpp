@@ -0,0 +1,222 @@
+#include "glasskey/cpu_renderer.h"
+#include "glasskey/font.h"
+#include "glasskey/worker_pool.h"
+
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GK_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+const std::uint32_t OPAQUE = 0xFF000000u;
+
+/** The glyph rows which bleed into the top of the next band */
+const int OVERHANG_LINES = gk::font::GLYPH_TOP + gk::font::GLYPH_HEIGHT - gk::ROW_HEIGHT;
+
+/** Redraws of fewer cells than this are not worth waking the render pool for */
+const std::size_t PARALLEL_CELLS = 8192;
+
+/** The font laid out by pixel row of a band, so that drawing a glyph row
+ *  needs no range checks: the rows of each glyph which fall inside its own
+ *  band, and those which fall inside the top of the band below.
+ */
+struct BandFont
+{
+    std::uint16_t lines[256][gk::ROW_HEIGHT];
+    std::uint16_t overhang[256][OVERHANG_LINES];
+
+    BandFont() : lines(),
+                 overhang()
+    {
+        for (int glyph = 0; glyph < 256; ++glyph)
+        {
+            for (int line = 0; line < gk::font::GLYPH_HEIGHT; ++line)
+            {
+                int y = gk::font::GLYPH_TOP + line;
+                if (y < gk::ROW_HEIGHT)
+                {
+                    lines[glyph][y] = gk::font::GLYPHS[glyph][line];
+                }
+                else
+                {
+                    overhang[glyph][y - gk::ROW_HEIGHT] = gk::font::GLYPHS[glyph][line];
+                }
+            }
+        }
+    }
+};
+
+const BandFont &band_font()
+{
+    static const BandFont font;
+    return font;
+}
+
+/** Writes one glyph row of a cell. Pixels lit in mask take color; the rest
+ *  take under_color where lit in under_mask, and background elsewhere.
+ */
+inline void draw_span(std::uint32_t *pixels, unsigned mask, std::uint32_t color, unsigned under_mask,
+                      std::uint32_t under_color, std::uint32_t background)
+{
+    static_assert(gk::COL_WIDTH == 9, "spans are written as 8 pixels and 1");
+    std::uint32_t last = (mask & 0x100) ? color : ((under_mask & 0x100) ? under_color : background);
+#if defined(__AVX2__)
+    const __m256i bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    __m256i lit = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(mask), bits), bits);
+    __m256i under = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(under_mask), bits), bits);
+    __m256i span = _mm256_blendv_epi8(_mm256_set1_epi32(background), _mm256_set1_epi32(under_color), under);
+    span = _mm256_blendv_epi8(span, _mm256_set1_epi32(color), lit);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(pixels), span);
+#elif defined(GK_SSE2)
+    const __m128i low_bits = _mm_setr_epi32(1, 2, 4, 8);
+    const __m128i high_bits = _mm_setr_epi32(16, 32, 64, 128);
+    __m128i lit_mask = _mm_set1_epi32(mask);
+    __m128i under_lit_mask = _mm_set1_epi32(under_mask);
+    __m128i colors = _mm_set1_epi32(color);
+    __m128i under_colors = _mm_set1_epi32(under_color);
+    __m128i backgrounds = _mm_set1_epi32(background);
+    for (int half = 0; half < 2; ++half)
+    {
+        __m128i bits = half ? high_bits : low_bits;
+        __m128i lit = _mm_cmpeq_epi32(_mm_and_si128(lit_mask, bits), bits);
+        __m128i under = _mm_cmpeq_epi32(_mm_and_si128(under_lit_mask, bits), bits);
+        __m128i span = _mm_or_si128(_mm_and_si128(under, under_colors), _mm_andnot_si128(under, backgrounds));
+        span = _mm_or_si128(_mm_and_si128(lit, colors), _mm_andnot_si128(lit, span));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pixels + 4 * half), span);
+    }
+#else
+    for (int x = 0; x < 8; ++x)
+    {
+        pixels[x] = ((mask >> x) & 1) ? color : (((under_mask >> x) & 1) ? under_color : background);
+    }
+#endif
+    pixels[8] = last;
+}
+} // namespace
+
+namespace gk
+{
+CpuRenderer::CpuRenderer(Size rows, Size cols) : m_rows(rows),
+                                                 m_cols(cols),
+                                                 m_is_valid(false),
+                                                 m_version(0),
+                                                 m_damaged(rows, true),
+                                                 m_edges(rows, 0)
+{
+    m_image.width = static_cast<std::uint32_t>(cols) * COL_WIDTH;
+    m_image.height = static_cast<std::uint32_t>(rows) * ROW_HEIGHT;
+    m_image.pixels.assign(static_cast<std::size_t>(m_image.width) * m_image.height, Colors::Black.rgba());
+    m_bands.reserve(rows);
+}
+
+const Image &CpuRenderer::image() const
+{
+    return m_image;
+}
+
+void CpuRenderer::render(const FrameView &frame)
+{
+    // scrolled rows are moved in the image rather than rasterized again
+    std::size_t band_size = static_cast<std::size_t>(ROW_HEIGHT) * m_image.width;
+    if (m_is_valid && !replay_shifts(frame, m_version, m_image.pixels.data(), band_size))
+    {
+        m_is_valid = false;
+    }
+
+    for (Size row = 0; row < m_rows; ++row)
+    {
+        m_damaged[row] = !m_is_valid || frame.row_versions[row] > m_version;
+    }
+
+    // the glyph overhang at the edges of a scrolled region does not move with
+    // it, and a later shift can carry an edge left by an earlier one elsewhere
+    std::fill(m_edges.begin(), m_edges.end(), 0);
+    for (std::size_t i = 0; m_is_valid && i < frame.shift_count; ++i)
+    {
+        const RowShift &shift = frame.shifts[i];
+        if (shift.version > m_version)
+        {
+            shift_rows(m_edges.data(), 1, shift);
+            m_edges[shift.top] = 1;
+            if (shift.bottom < static_cast<Index>(m_rows))
+            {
+                m_edges[shift.bottom] = 1;
+            }
+        }
+    }
+
+    for (Size row = 0; row < m_rows; ++row)
+    {
+        m_damaged[row] = m_damaged[row] || m_edges[row];
+    }
+
+    // the pixels of a row also show the overhang of the glyphs in the row above
+    m_bands.clear();
+    for (Size row = 0; row < m_rows; ++row)
+    {
+        if (m_damaged[row] || (row > 0 && m_damaged[row - 1]))
+        {
+            m_bands.push_back(row);
+        }
+    }
+
+    // bands write disjoint pixels, so they can be drawn in any order
+    WorkerPool &pool = render_pool();
+    std::size_t chunks = 1;
+    if (m_bands.size() * m_cols >= PARALLEL_CELLS)
+    {
+        chunks = std::min<std::size_t>(m_bands.size(), pool.threads() * 4);
+    }
+
+    pool.run(chunks, [this, &frame, chunks](std::size_t chunk) {
+        std::size_t end = m_bands.size() * (chunk + 1) / chunks;
+        for (std::size_t i = m_bands.size() * chunk / chunks; i < end; ++i)
+        {
+            draw_band(frame, m_bands[i]);
+        }
+    });
+
+    m_version = frame.version;
+    m_is_valid = true;
+}
+
+void CpuRenderer::draw_band(const FrameView &frame, Size row)
+{
+    const BandFont &font = band_font();
+    const std::vector<Color> &palette = *frame.palette;
+    const std::uint32_t background = Colors::Black.rgba();
+    const std::size_t width = m_image.width;
+    std::uint32_t *band = m_image.pixels.data() + static_cast<std::size_t>(row) * ROW_HEIGHT * width;
+    const Cell *cell = frame.cells + static_cast<std::size_t>(row) * m_cols;
+    const Cell *above = row > 0 ? cell - m_cols : nullptr;
+
+    // every pixel of the band is written exactly once, so it needs no clearing
+    for (Size col = 0; col < m_cols; ++col, ++cell)
+    {
+        const std::uint16_t *lines = font.lines[static_cast<std::uint8_t>(cell->value)];
+        std::uint32_t color = palette[cell->color].rgba() | OPAQUE;
+        std::uint32_t *pixels = band + static_cast<std::size_t>(col) * COL_WIDTH;
+        int line = 0;
+        if (above)
+        {
+            const Cell &source = above[col];
+            const std::uint16_t *overhang = font.overhang[static_cast<std::uint8_t>(source.value)];
+            std::uint32_t above_color = palette[source.color].rgba() | OPAQUE;
+            for (; line < OVERHANG_LINES; ++line, pixels += width)
+            {
+                draw_span(pixels, lines[line], color, overhang[line], above_color, background);
+            }
+        }
+
+        for (; line < ROW_HEIGHT; ++line, pixels += width)
+        {
+            draw_span(pixels, lines[line], color, 0, 0, background);
+        }
+    }
+}
+} // namespace gk
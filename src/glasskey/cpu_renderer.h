@@ -0,0 +1,47 @@
+#ifndef _GK_CPU_RENDERER_H_
+#define _GK_CPU_RENDERER_H_
+
+#include "glasskey/frame_renderer.h"
+
+namespace gk
+{
+/** Rasterizes the frames of a TextGrid into an RGBA image entirely on the CPU,
+ *  placing glyphs exactly as the OpenGL backend does. Only the pixel rows
+ *  affected by damaged grid rows are redrawn, and scrolled rows are moved.
+ *  Each glyph row is written as a 9 pixel span with SSE2 or AVX2 where the
+ *  build allows, and large redraws are split across the render pool.
+ */
+class CpuRenderer : public FrameRenderer
+{
+public:
+    /** Constructor.
+     *
+     *  \param rows the number of rows in the grid
+     *  \param cols the number of columns in the grid
+     */
+    CpuRenderer(Size rows, Size cols);
+
+    /** Rasterizes the changed rows of the frame into the image.
+     *
+     *  \param frame the frame to draw
+     */
+    void render(const FrameView &frame) override;
+
+    /** The image of the most recently rendered frame */
+    const Image &image() const;
+
+private:
+    void draw_band(const FrameView &frame, Size row);
+
+    const Size m_rows;
+    const Size m_cols;
+    Image m_image;
+    bool m_is_valid;
+    std::uint64_t m_version;
+    std::vector<bool> m_damaged;
+    std::vector<std::uint8_t> m_edges;
+    std::vector<Size> m_bands;
+};
+} // namespace gk
+
+#endif
@@ -0,0 +1,56 @@
+#include "glasskey/glasskey.h"
+
+namespace gk
+{
+DrawBatch &DrawBatch::draw(Index row, Index col, const std::string &values)
+{
+    m_commands.push_back({Op::TEXT, 0, row, col, 0, 0, m_text.size(), values.size()});
+    m_text.append(values);
+    return *this;
+}
+
+DrawBatch &DrawBatch::draw(Index row, Index col, const std::vector<Letter> &letters)
+{
+    m_commands.push_back({Op::LETTERS, 0, row, col, 0, 0, m_letters.size(), letters.size()});
+    m_letters.insert(m_letters.end(), letters.begin(), letters.end());
+    return *this;
+}
+
+DrawBatch &DrawBatch::draw(const Rect &rect, char value)
+{
+    m_commands.push_back({Op::FILL, value, rect.top(), rect.left(), rect.width(), rect.height(), 0, 0});
+    return *this;
+}
+
+DrawBatch &DrawBatch::clear(Index row, Index col, Size cols)
+{
+    m_commands.push_back({Op::CLEAR, ' ', row, col, cols, 1, 0, 0});
+    return *this;
+}
+
+DrawBatch &DrawBatch::clear(const Rect &rect)
+{
+    m_commands.push_back({Op::CLEAR, ' ', rect.top(), rect.left(), rect.width(), rect.height(), 0, 0});
+    return *this;
+}
+
+DrawBatch &DrawBatch::blit_sprite(const Sprite &sprite, Index row, Index col)
+{
+    m_commands.push_back({Op::SPRITE, 0, row, col, 0, 0, m_sprites.size(), 1});
+    m_sprites.push_back(&sprite);
+    return *this;
+}
+
+void DrawBatch::reset()
+{
+    m_commands.clear();
+    m_text.clear();
+    m_letters.clear();
+    m_sprites.clear();
+}
+
+std::size_t DrawBatch::size() const
+{
+    return m_commands.size();
+}
+} // namespace gk
@@ -0,0 +1,251 @@
+#include "glasskey/glasskey.h"
+
+#include <thread>
+
+namespace
+{
+/** The ring needs at least two slots, so that the sequence of a full slot
+ *  never equals that of a free one
+ */
+std::size_t round_capacity(std::size_t capacity)
+{
+    std::size_t rounded = 2;
+    while (rounded < capacity)
+    {
+        rounded *= 2;
+    }
+
+    return rounded;
+}
+
+/** The cells a command draws to, as row, column, width and height */
+struct Extent
+{
+    std::int64_t row;
+    std::int64_t col;
+    std::uint64_t width;
+    std::uint64_t height;
+};
+} // namespace
+
+namespace gk
+{
+DrawQueue::DrawQueue(std::size_t capacity, BackPressure back_pressure) : m_capacity(round_capacity(capacity)),
+                                                                         m_back_pressure(back_pressure),
+                                                                         m_slots(new Slot[m_capacity]),
+                                                                         m_head(0),
+                                                                         m_tail(0),
+                                                                         m_dropped(0),
+                                                                         m_coalesced(0)
+{
+    for (std::size_t i = 0; i < m_capacity; ++i)
+    {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+DrawQueue &DrawQueue::draw(Index row, Index col, const std::string &values)
+{
+    push({DrawBatch::Op::TEXT, 0, row, col, 0, 0, 0, values.size()}, values.data(), nullptr);
+    return *this;
+}
+
+DrawQueue &DrawQueue::draw(Index row, Index col, const std::vector<Letter> &letters)
+{
+    push({DrawBatch::Op::LETTERS, 0, row, col, 0, 0, 0, letters.size()}, nullptr, letters.data());
+    return *this;
+}
+
+DrawQueue &DrawQueue::draw(const Rect &rect, char value)
+{
+    push({DrawBatch::Op::FILL, value, rect.top(), rect.left(), rect.width(), rect.height(), 0, 0}, nullptr, nullptr);
+    return *this;
+}
+
+DrawQueue &DrawQueue::clear(Index row, Index col, Size cols)
+{
+    push({DrawBatch::Op::CLEAR, ' ', row, col, cols, 1, 0, 0}, nullptr, nullptr);
+    return *this;
+}
+
+DrawQueue &DrawQueue::clear(const Rect &rect)
+{
+    push({DrawBatch::Op::CLEAR, ' ', rect.top(), rect.left(), rect.width(), rect.height(), 0, 0}, nullptr, nullptr);
+    return *this;
+}
+
+std::size_t DrawQueue::capacity() const
+{
+    return m_capacity;
+}
+
+BackPressure DrawQueue::back_pressure() const
+{
+    return m_back_pressure;
+}
+
+std::size_t DrawQueue::size() const
+{
+    std::uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    std::uint64_t head = m_head.load(std::memory_order_relaxed);
+    return head > tail ? static_cast<std::size_t>(head - tail) : 0;
+}
+
+std::uint64_t DrawQueue::dropped() const
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+std::uint64_t DrawQueue::coalesced() const
+{
+    return m_coalesced.load(std::memory_order_relaxed);
+}
+
+void DrawQueue::write(Slot &slot, const DrawBatch::Command &command, const char *text, const Letter *letters)
+{
+    slot.command = command;
+    if (command.op == DrawBatch::Op::TEXT)
+    {
+        slot.text.assign(text, command.count);
+    }
+    else if (command.op == DrawBatch::Op::LETTERS)
+    {
+        slot.letters.assign(letters, letters + command.count);
+    }
+}
+
+void DrawQueue::push(const DrawBatch::Command &command, const char *text, const Letter *letters)
+{
+    const std::uint64_t mask = m_capacity - 1;
+    std::uint64_t position = m_head.load(std::memory_order_relaxed);
+    while (true)
+    {
+        Slot &slot = m_slots[position & mask];
+        std::uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        std::int64_t difference = static_cast<std::int64_t>(sequence - position);
+        if (difference == 0)
+        {
+            if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                write(slot, command, text, letters);
+                slot.sequence.store(position + 1, std::memory_order_release);
+                return;
+            }
+
+            continue;
+        }
+
+        if (difference > 0)
+        {
+            // another producer took this slot first
+            position = m_head.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        // the queue is full
+        if (m_back_pressure == BackPressure::COALESCE && coalesce(command, text, letters))
+        {
+            m_coalesced.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        Slot *oldest = m_back_pressure == BackPressure::BLOCK ? nullptr : claim();
+        if (oldest)
+        {
+            release(oldest);
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+
+        position = m_head.load(std::memory_order_relaxed);
+    }
+}
+
+bool DrawQueue::coalesce(const DrawBatch::Command &command, const char *text, const Letter *letters)
+{
+    auto extent_of = [](const DrawBatch::Command &pending) -> Extent {
+        if (pending.op == DrawBatch::Op::TEXT || pending.op == DrawBatch::Op::LETTERS)
+        {
+            return {pending.row, pending.col, pending.count, 1};
+        }
+
+        return {pending.row, pending.col, pending.width, pending.height};
+    };
+
+    const Extent target = extent_of(command);
+    const std::uint64_t mask = m_capacity - 1;
+
+    // replacing a command moves it past every command added after it, so the
+    // search stops at the first newer command which draws to the same cells
+    const std::uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    for (std::uint64_t position = m_head.load(std::memory_order_relaxed); position-- > tail;)
+    {
+        // the slot is held while it is compared, so it cannot be applied half-written.
+        // A slot which cannot be held is still being written, or has been applied
+        // along with all of those before it, and either way nothing older is safe.
+        Slot &slot = m_slots[position & mask];
+        std::uint64_t sequence = position + 1;
+        if (!slot.sequence.compare_exchange_strong(sequence, position, std::memory_order_acquire,
+                                                   std::memory_order_relaxed))
+        {
+            return false;
+        }
+
+        Extent pending = extent_of(slot.command);
+        bool is_same = pending.row == target.row && pending.col == target.col &&
+                       pending.width == target.width && pending.height == target.height;
+        bool is_overlapping = pending.row < target.row + static_cast<std::int64_t>(target.height) &&
+                              target.row < pending.row + static_cast<std::int64_t>(pending.height) &&
+                              pending.col < target.col + static_cast<std::int64_t>(target.width) &&
+                              target.col < pending.col + static_cast<std::int64_t>(pending.width);
+        if (is_same)
+        {
+            write(slot, command, text, letters);
+        }
+
+        slot.sequence.store(position + 1, std::memory_order_release);
+        if (is_same || is_overlapping)
+        {
+            return is_same;
+        }
+    }
+
+    return false;
+}
+
+DrawQueue::Slot *DrawQueue::claim()
+{
+    const std::uint64_t mask = m_capacity - 1;
+    std::uint64_t position = m_tail.load(std::memory_order_relaxed);
+    while (true)
+    {
+        Slot &slot = m_slots[position & mask];
+        std::uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        std::int64_t difference = static_cast<std::int64_t>(sequence - (position + 1));
+        if (difference == 0 && slot.sequence.compare_exchange_weak(sequence, position, std::memory_order_acquire,
+                                                                    std::memory_order_relaxed))
+        {
+            // only the holder of the oldest slot moves the tail past it
+            m_tail.store(position + 1, std::memory_order_relaxed);
+            return &slot;
+        }
+
+        std::uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        if (difference < 0 && tail == position)
+        {
+            // empty, or the oldest command is still being written or replaced
+            return nullptr;
+        }
+
+        position = tail;
+    }
+}
+
+void DrawQueue::release(Slot *slot)
+{
+    slot->sequence.store(slot->sequence.load(std::memory_order_relaxed) + m_capacity, std::memory_order_release);
+}
+} // namespace gk
@@ -0,0 +1,268 @@
+#include "glasskey/font.h"
+
+namespace gk
+{
+namespace font
+{
+// Bitmaps from the X11 "-misc-fixed-medium-r-normal--15-140-75-75-C-90-iso8859-1"
+// font (public domain), as distributed with freeglut.
+const std::uint16_t GLYPHS[256][GLYPH_HEIGHT] = {
+    {0x000, 0x000, 0x0b6, 0x080, 0x002, 0x082, 0x080, 0x002, 0x082, 0x080, 0x002, 0x0da, 0x000, 0x000, 0x000, 0x000}, // 0
+    {0x000, 0x000, 0x000, 0x010, 0x038, 0x07c, 0x0fe, 0x1ff, 0x0fe, 0x07c, 0x038, 0x010, 0x000, 0x000, 0x000, 0x000}, // 1
+    {0x155, 0x0aa, 0x155, 0x0aa, 0x155, 0x0aa, 0x155, 0x0aa, 0x155, 0x0aa, 0x155, 0x0aa, 0x155, 0x0aa, 0x155, 0x000}, // 2
+    {0x000, 0x012, 0x012, 0x01e, 0x012, 0x012, 0x000, 0x0f8, 0x020, 0x020, 0x020, 0x020, 0x000, 0x000, 0x000, 0x000}, // 3
+    {0x000, 0x000, 0x01e, 0x002, 0x00e, 0x002, 0x0f2, 0x012, 0x070, 0x010, 0x010, 0x010, 0x000, 0x000, 0x000, 0x000}, // 4
+    {0x000, 0x01c, 0x002, 0x002, 0x002, 0x01c, 0x000, 0x070, 0x090, 0x070, 0x090, 0x090, 0x000, 0x000, 0x000, 0x000}, // 5
+    {0x000, 0x002, 0x002, 0x002, 0x002, 0x01e, 0x000, 0x0f0, 0x010, 0x070, 0x010, 0x010, 0x000, 0x000, 0x000, 0x000}, // 6
+    {0x000, 0x000, 0x030, 0x048, 0x048, 0x030, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 7
+    {0x000, 0x000, 0x010, 0x010, 0x010, 0x0fe, 0x010, 0x010, 0x010, 0x000, 0x0fe, 0x000, 0x000, 0x000, 0x000, 0x000}, // 8
+    {0x000, 0x022, 0x026, 0x02a, 0x032, 0x022, 0x000, 0x010, 0x010, 0x010, 0x010, 0x0f0, 0x000, 0x000, 0x000, 0x000}, // 9
+    {0x000, 0x022, 0x022, 0x014, 0x014, 0x008, 0x000, 0x0f8, 0x020, 0x020, 0x020, 0x020, 0x000, 0x000, 0x000, 0x000}, // 10
+    {0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x01f, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 11
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x01f, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x000}, // 12
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x1f0, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x000}, // 13
+    {0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x1f0, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 14
+    {0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x1ff, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x000}, // 15
+    {0x1ff, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 16
+    {0x000, 0x000, 0x000, 0x1ff, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 17
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x1ff, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 18
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x1ff, 0x000, 0x000, 0x000, 0x000}, // 19
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x1ff, 0x000}, // 20
+    {0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x1f0, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x000}, // 21
+    {0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x01f, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x000}, // 22
+    {0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x1ff, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 23
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x1ff, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x000}, // 24
+    {0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x000}, // 25
+    {0x000, 0x000, 0x000, 0x000, 0x0c0, 0x038, 0x006, 0x038, 0x0c0, 0x000, 0x0fe, 0x000, 0x000, 0x000, 0x000, 0x000}, // 26
+    {0x000, 0x000, 0x000, 0x000, 0x006, 0x038, 0x0c0, 0x038, 0x006, 0x000, 0x0fe, 0x000, 0x000, 0x000, 0x000, 0x000}, // 27
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x0fe, 0x044, 0x044, 0x044, 0x044, 0x044, 0x044, 0x000, 0x000, 0x000, 0x000}, // 28
+    {0x000, 0x000, 0x000, 0x000, 0x020, 0x020, 0x0fe, 0x010, 0x0fe, 0x008, 0x008, 0x000, 0x000, 0x000, 0x000, 0x000}, // 29
+    {0x000, 0x000, 0x070, 0x088, 0x008, 0x008, 0x03e, 0x008, 0x008, 0x00c, 0x08a, 0x074, 0x000, 0x000, 0x000, 0x000}, // 30
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x030, 0x030, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 31
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // ' '
+    {0x000, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x000, 0x000, 0x010, 0x010, 0x000, 0x000, 0x000, 0x000}, // '!'
+    {0x000, 0x000, 0x048, 0x048, 0x048, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // '"'
+    {0x000, 0x000, 0x000, 0x024, 0x024, 0x07e, 0x024, 0x024, 0x07e, 0x024, 0x024, 0x000, 0x000, 0x000, 0x000, 0x000}, // '#'
+    {0x000, 0x010, 0x07c, 0x092, 0x012, 0x014, 0x038, 0x050, 0x090, 0x090, 0x092, 0x07c, 0x010, 0x000, 0x000, 0x000}, // '$'
+    {0x000, 0x000, 0x084, 0x04a, 0x04a, 0x024, 0x010, 0x010, 0x048, 0x0a4, 0x0a4, 0x042, 0x000, 0x000, 0x000, 0x000}, // '%'
+    {0x000, 0x000, 0x00c, 0x012, 0x012, 0x012, 0x00c, 0x08c, 0x052, 0x022, 0x052, 0x08c, 0x000, 0x000, 0x000, 0x000}, // '&'
+    {0x000, 0x000, 0x060, 0x020, 0x010, 0x008, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // '''
+    {0x000, 0x020, 0x010, 0x010, 0x008, 0x008, 0x008, 0x008, 0x008, 0x008, 0x010, 0x010, 0x020, 0x000, 0x000, 0x000}, // '('
+    {0x000, 0x008, 0x010, 0x010, 0x020, 0x020, 0x020, 0x020, 0x020, 0x020, 0x010, 0x010, 0x008, 0x000, 0x000, 0x000}, // ')'
+    {0x000, 0x000, 0x000, 0x000, 0x010, 0x092, 0x054, 0x038, 0x054, 0x092, 0x010, 0x000, 0x000, 0x000, 0x000, 0x000}, // '*'
+    {0x000, 0x000, 0x000, 0x000, 0x010, 0x010, 0x010, 0x0fe, 0x010, 0x010, 0x010, 0x000, 0x000, 0x000, 0x000, 0x000}, // '+'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x030, 0x030, 0x020, 0x020, 0x010, 0x000}, // ','
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x0fe, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // '-'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x030, 0x030, 0x000, 0x000, 0x000, 0x000}, // '.'
+    {0x000, 0x000, 0x080, 0x040, 0x040, 0x020, 0x010, 0x010, 0x008, 0x004, 0x004, 0x002, 0x000, 0x000, 0x000, 0x000}, // '/'
+    {0x000, 0x000, 0x038, 0x044, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x044, 0x038, 0x000, 0x000, 0x000, 0x000}, // '0'
+    {0x000, 0x000, 0x010, 0x018, 0x014, 0x012, 0x010, 0x010, 0x010, 0x010, 0x010, 0x0fe, 0x000, 0x000, 0x000, 0x000}, // '1'
+    {0x000, 0x000, 0x07c, 0x082, 0x082, 0x040, 0x020, 0x010, 0x008, 0x004, 0x002, 0x0fe, 0x000, 0x000, 0x000, 0x000}, // '2'
+    {0x000, 0x000, 0x0fe, 0x080, 0x040, 0x020, 0x070, 0x080, 0x080, 0x080, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // '3'
+    {0x000, 0x000, 0x040, 0x060, 0x050, 0x048, 0x044, 0x042, 0x0fe, 0x040, 0x040, 0x040, 0x000, 0x000, 0x000, 0x000}, // '4'
+    {0x000, 0x000, 0x0fe, 0x002, 0x002, 0x07a, 0x086, 0x080, 0x080, 0x080, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // '5'
+    {0x000, 0x000, 0x078, 0x004, 0x002, 0x002, 0x07a, 0x086, 0x082, 0x082, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // '6'
+    {0x000, 0x000, 0x0fe, 0x080, 0x080, 0x040, 0x020, 0x010, 0x008, 0x008, 0x004, 0x004, 0x000, 0x000, 0x000, 0x000}, // '7'
+    {0x000, 0x000, 0x038, 0x044, 0x082, 0x044, 0x038, 0x044, 0x082, 0x082, 0x044, 0x038, 0x000, 0x000, 0x000, 0x000}, // '8'
+    {0x000, 0x000, 0x07c, 0x082, 0x082, 0x082, 0x0c2, 0x0bc, 0x080, 0x080, 0x040, 0x03c, 0x000, 0x000, 0x000, 0x000}, // '9'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x030, 0x030, 0x000, 0x000, 0x000, 0x030, 0x030, 0x000, 0x000, 0x000, 0x000}, // ':'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x030, 0x030, 0x000, 0x000, 0x000, 0x030, 0x030, 0x020, 0x020, 0x010, 0x000}, // ';'
+    {0x000, 0x000, 0x040, 0x020, 0x010, 0x008, 0x004, 0x004, 0x008, 0x010, 0x020, 0x040, 0x000, 0x000, 0x000, 0x000}, // '<'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x0fe, 0x000, 0x000, 0x0fe, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // '='
+    {0x000, 0x000, 0x004, 0x008, 0x010, 0x020, 0x040, 0x040, 0x020, 0x010, 0x008, 0x004, 0x000, 0x000, 0x000, 0x000}, // '>'
+    {0x000, 0x000, 0x07c, 0x082, 0x082, 0x080, 0x040, 0x020, 0x010, 0x010, 0x000, 0x010, 0x000, 0x000, 0x000, 0x000}, // '?'
+    {0x000, 0x000, 0x07c, 0x082, 0x082, 0x0f2, 0x08a, 0x0ca, 0x0b2, 0x002, 0x002, 0x07c, 0x000, 0x000, 0x000, 0x000}, // '@'
+    {0x000, 0x000, 0x010, 0x028, 0x044, 0x082, 0x082, 0x082, 0x0fe, 0x082, 0x082, 0x082, 0x000, 0x000, 0x000, 0x000}, // 'A'
+    {0x000, 0x000, 0x07e, 0x084, 0x084, 0x084, 0x07e, 0x084, 0x084, 0x084, 0x084, 0x07e, 0x000, 0x000, 0x000, 0x000}, // 'B'
+    {0x000, 0x000, 0x07c, 0x082, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 'C'
+    {0x000, 0x000, 0x07e, 0x084, 0x084, 0x084, 0x084, 0x084, 0x084, 0x084, 0x084, 0x07e, 0x000, 0x000, 0x000, 0x000}, // 'D'
+    {0x000, 0x000, 0x0fe, 0x004, 0x004, 0x004, 0x03c, 0x004, 0x004, 0x004, 0x004, 0x0fe, 0x000, 0x000, 0x000, 0x000}, // 'E'
+    {0x000, 0x000, 0x0fe, 0x004, 0x004, 0x004, 0x03c, 0x004, 0x004, 0x004, 0x004, 0x004, 0x000, 0x000, 0x000, 0x000}, // 'F'
+    {0x000, 0x000, 0x07c, 0x082, 0x002, 0x002, 0x002, 0x0e2, 0x082, 0x082, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 'G'
+    {0x000, 0x000, 0x082, 0x082, 0x082, 0x082, 0x0fe, 0x082, 0x082, 0x082, 0x082, 0x082, 0x000, 0x000, 0x000, 0x000}, // 'H'
+    {0x000, 0x000, 0x07c, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 'I'
+    {0x000, 0x000, 0x1f0, 0x040, 0x040, 0x040, 0x040, 0x040, 0x040, 0x040, 0x042, 0x03c, 0x000, 0x000, 0x000, 0x000}, // 'J'
+    {0x000, 0x000, 0x082, 0x042, 0x022, 0x012, 0x00e, 0x00a, 0x012, 0x022, 0x042, 0x082, 0x000, 0x000, 0x000, 0x000}, // 'K'
+    {0x000, 0x000, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x0fe, 0x000, 0x000, 0x000, 0x000}, // 'L'
+    {0x000, 0x000, 0x082, 0x082, 0x0c6, 0x0aa, 0x0aa, 0x092, 0x092, 0x082, 0x082, 0x082, 0x000, 0x000, 0x000, 0x000}, // 'M'
+    {0x000, 0x000, 0x082, 0x082, 0x086, 0x08a, 0x092, 0x0a2, 0x0c2, 0x082, 0x082, 0x082, 0x000, 0x000, 0x000, 0x000}, // 'N'
+    {0x000, 0x000, 0x07c, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 'O'
+    {0x000, 0x000, 0x07e, 0x082, 0x082, 0x082, 0x07e, 0x002, 0x002, 0x002, 0x002, 0x002, 0x000, 0x000, 0x000, 0x000}, // 'P'
+    {0x000, 0x000, 0x07c, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x08a, 0x092, 0x07c, 0x020, 0x0c0, 0x000, 0x000}, // 'Q'
+    {0x000, 0x000, 0x07e, 0x082, 0x082, 0x082, 0x07e, 0x012, 0x022, 0x042, 0x082, 0x082, 0x000, 0x000, 0x000, 0x000}, // 'R'
+    {0x000, 0x000, 0x07c, 0x082, 0x082, 0x002, 0x01c, 0x060, 0x080, 0x082, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 'S'
+    {0x000, 0x000, 0x0fe, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x000, 0x000, 0x000, 0x000}, // 'T'
+    {0x000, 0x000, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 'U'
+    {0x000, 0x000, 0x082, 0x082, 0x082, 0x044, 0x044, 0x044, 0x028, 0x028, 0x028, 0x010, 0x000, 0x000, 0x000, 0x000}, // 'V'
+    {0x000, 0x000, 0x082, 0x082, 0x082, 0x082, 0x092, 0x092, 0x092, 0x092, 0x0aa, 0x044, 0x000, 0x000, 0x000, 0x000}, // 'W'
+    {0x000, 0x000, 0x082, 0x082, 0x044, 0x028, 0x010, 0x010, 0x028, 0x044, 0x082, 0x082, 0x000, 0x000, 0x000, 0x000}, // 'X'
+    {0x000, 0x000, 0x082, 0x082, 0x044, 0x028, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x000, 0x000, 0x000, 0x000}, // 'Y'
+    {0x000, 0x000, 0x0fe, 0x080, 0x040, 0x020, 0x010, 0x008, 0x004, 0x002, 0x002, 0x0fe, 0x000, 0x000, 0x000, 0x000}, // 'Z'
+    {0x000, 0x078, 0x008, 0x008, 0x008, 0x008, 0x008, 0x008, 0x008, 0x008, 0x008, 0x008, 0x078, 0x000, 0x000, 0x000}, // '['
+    {0x000, 0x000, 0x002, 0x004, 0x004, 0x008, 0x010, 0x010, 0x020, 0x040, 0x040, 0x080, 0x000, 0x000, 0x000, 0x000}, // 92
+    {0x000, 0x03c, 0x020, 0x020, 0x020, 0x020, 0x020, 0x020, 0x020, 0x020, 0x020, 0x020, 0x03c, 0x000, 0x000, 0x000}, // ']'
+    {0x000, 0x000, 0x010, 0x028, 0x044, 0x082, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // '^'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x0ff, 0x000, 0x000, 0x000}, // '_'
+    {0x000, 0x00c, 0x008, 0x010, 0x020, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // '`'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x07c, 0x080, 0x080, 0x0fc, 0x082, 0x0c2, 0x0bc, 0x000, 0x000, 0x000, 0x000}, // 'a'
+    {0x000, 0x000, 0x002, 0x002, 0x002, 0x07a, 0x086, 0x082, 0x082, 0x082, 0x086, 0x07a, 0x000, 0x000, 0x000, 0x000}, // 'b'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x07c, 0x082, 0x002, 0x002, 0x002, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 'c'
+    {0x000, 0x000, 0x080, 0x080, 0x080, 0x0bc, 0x0c2, 0x082, 0x082, 0x082, 0x0c2, 0x0bc, 0x000, 0x000, 0x000, 0x000}, // 'd'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x07c, 0x082, 0x082, 0x0fe, 0x002, 0x002, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 'e'
+    {0x000, 0x000, 0x070, 0x088, 0x088, 0x008, 0x008, 0x03e, 0x008, 0x008, 0x008, 0x008, 0x000, 0x000, 0x000, 0x000}, // 'f'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x0bc, 0x042, 0x042, 0x042, 0x03c, 0x002, 0x07c, 0x082, 0x082, 0x07c, 0x000}, // 'g'
+    {0x000, 0x000, 0x002, 0x002, 0x002, 0x07a, 0x086, 0x082, 0x082, 0x082, 0x082, 0x082, 0x000, 0x000, 0x000, 0x000}, // 'h'
+    {0x000, 0x000, 0x018, 0x000, 0x000, 0x01c, 0x010, 0x010, 0x010, 0x010, 0x010, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 'i'
+    {0x000, 0x000, 0x060, 0x000, 0x000, 0x070, 0x040, 0x040, 0x040, 0x040, 0x040, 0x042, 0x042, 0x042, 0x03c, 0x000}, // 'j'
+    {0x000, 0x000, 0x002, 0x002, 0x002, 0x082, 0x062, 0x01a, 0x006, 0x01a, 0x062, 0x082, 0x000, 0x000, 0x000, 0x000}, // 'k'
+    {0x000, 0x000, 0x01c, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 'l'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x06e, 0x092, 0x092, 0x092, 0x092, 0x092, 0x082, 0x000, 0x000, 0x000, 0x000}, // 'm'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x07a, 0x086, 0x082, 0x082, 0x082, 0x082, 0x082, 0x000, 0x000, 0x000, 0x000}, // 'n'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x07c, 0x082, 0x082, 0x082, 0x082, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 'o'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x07a, 0x086, 0x082, 0x082, 0x082, 0x086, 0x07a, 0x002, 0x002, 0x002, 0x000}, // 'p'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x0bc, 0x0c2, 0x082, 0x082, 0x082, 0x0c2, 0x0bc, 0x080, 0x080, 0x080, 0x000}, // 'q'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x072, 0x08c, 0x084, 0x004, 0x004, 0x004, 0x004, 0x000, 0x000, 0x000, 0x000}, // 'r'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x07c, 0x082, 0x002, 0x07c, 0x080, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 's'
+    {0x000, 0x000, 0x000, 0x008, 0x008, 0x07e, 0x008, 0x008, 0x008, 0x008, 0x088, 0x070, 0x000, 0x000, 0x000, 0x000}, // 't'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x0bc, 0x000, 0x000, 0x000, 0x000}, // 'u'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x082, 0x082, 0x044, 0x044, 0x028, 0x028, 0x010, 0x000, 0x000, 0x000, 0x000}, // 'v'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x082, 0x082, 0x092, 0x092, 0x092, 0x0aa, 0x044, 0x000, 0x000, 0x000, 0x000}, // 'w'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x082, 0x044, 0x028, 0x010, 0x028, 0x044, 0x082, 0x000, 0x000, 0x000, 0x000}, // 'x'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x042, 0x042, 0x042, 0x042, 0x042, 0x062, 0x05c, 0x040, 0x042, 0x03c, 0x000}, // 'y'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x0fe, 0x040, 0x020, 0x010, 0x008, 0x004, 0x0fe, 0x000, 0x000, 0x000, 0x000}, // 'z'
+    {0x000, 0x0e0, 0x010, 0x010, 0x010, 0x020, 0x018, 0x018, 0x020, 0x010, 0x010, 0x010, 0x0e0, 0x000, 0x000, 0x000}, // '{'
+    {0x000, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x000, 0x000, 0x000}, // '|'
+    {0x000, 0x00e, 0x010, 0x010, 0x010, 0x008, 0x030, 0x030, 0x008, 0x010, 0x010, 0x010, 0x00e, 0x000, 0x000, 0x000}, // '}'
+    {0x000, 0x000, 0x08c, 0x092, 0x062, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // '~'
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 127
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 128
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 129
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 130
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 131
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 132
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 133
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 134
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 135
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 136
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 137
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 138
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 139
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 140
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 141
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 142
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 143
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 144
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 145
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 146
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 147
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 148
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 149
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 150
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 151
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 152
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 153
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 154
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 155
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 156
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 157
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 158
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 159
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 160
+    {0x000, 0x010, 0x010, 0x000, 0x000, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x000, 0x000, 0x000, 0x000}, // 161
+    {0x000, 0x000, 0x000, 0x000, 0x020, 0x03c, 0x052, 0x012, 0x00a, 0x04a, 0x03c, 0x004, 0x000, 0x000, 0x000, 0x000}, // 162
+    {0x000, 0x000, 0x070, 0x088, 0x008, 0x008, 0x03e, 0x008, 0x008, 0x00c, 0x08a, 0x074, 0x000, 0x000, 0x000, 0x000}, // 163
+    {0x000, 0x000, 0x000, 0x082, 0x07c, 0x044, 0x044, 0x07c, 0x082, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 164
+    {0x000, 0x000, 0x082, 0x082, 0x044, 0x028, 0x07c, 0x010, 0x07c, 0x010, 0x010, 0x010, 0x000, 0x000, 0x000, 0x000}, // 165
+    {0x000, 0x000, 0x010, 0x010, 0x010, 0x010, 0x010, 0x000, 0x010, 0x010, 0x010, 0x010, 0x010, 0x000, 0x000, 0x000}, // 166
+    {0x000, 0x000, 0x018, 0x024, 0x004, 0x018, 0x024, 0x024, 0x024, 0x018, 0x020, 0x024, 0x018, 0x000, 0x000, 0x000}, // 167
+    {0x000, 0x044, 0x044, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 168
+    {0x000, 0x000, 0x03c, 0x042, 0x099, 0x0a5, 0x085, 0x0a5, 0x099, 0x042, 0x03c, 0x000, 0x000, 0x000, 0x000, 0x000}, // 169
+    {0x000, 0x000, 0x00c, 0x012, 0x01c, 0x012, 0x03c, 0x000, 0x03e, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 170
+    {0x000, 0x000, 0x000, 0x090, 0x048, 0x024, 0x012, 0x012, 0x024, 0x048, 0x090, 0x000, 0x000, 0x000, 0x000, 0x000}, // 171
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x07e, 0x040, 0x040, 0x040, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 172
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x07c, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 173
+    {0x000, 0x000, 0x03c, 0x042, 0x09d, 0x0a5, 0x09d, 0x095, 0x0a5, 0x042, 0x03c, 0x000, 0x000, 0x000, 0x000, 0x000}, // 174
+    {0x000, 0x000, 0x07e, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 175
+    {0x000, 0x000, 0x030, 0x048, 0x048, 0x030, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 176
+    {0x000, 0x000, 0x010, 0x010, 0x010, 0x0fe, 0x010, 0x010, 0x010, 0x000, 0x0fe, 0x000, 0x000, 0x000, 0x000, 0x000}, // 177
+    {0x000, 0x000, 0x00c, 0x012, 0x010, 0x00c, 0x002, 0x01e, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 178
+    {0x000, 0x000, 0x00c, 0x012, 0x008, 0x010, 0x012, 0x00c, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 179
+    {0x000, 0x020, 0x010, 0x008, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 180
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x082, 0x082, 0x082, 0x082, 0x082, 0x0c6, 0x0ba, 0x002, 0x002, 0x000, 0x000}, // 181
+    {0x000, 0x000, 0x0fc, 0x0a2, 0x0a2, 0x0a2, 0x0bc, 0x0a0, 0x0a0, 0x0a0, 0x0a0, 0x0a0, 0x000, 0x000, 0x000, 0x000}, // 182
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x030, 0x030, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 183
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x030, 0x024, 0x018, 0x000}, // 184
+    {0x000, 0x000, 0x004, 0x006, 0x004, 0x004, 0x004, 0x00e, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 185
+    {0x000, 0x000, 0x01c, 0x022, 0x022, 0x01c, 0x000, 0x03e, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000}, // 186
+    {0x000, 0x000, 0x000, 0x012, 0x024, 0x048, 0x090, 0x090, 0x048, 0x024, 0x012, 0x000, 0x000, 0x000, 0x000, 0x000}, // 187
+    {0x000, 0x000, 0x004, 0x006, 0x004, 0x004, 0x084, 0x0ce, 0x0a0, 0x090, 0x0b0, 0x0c0, 0x000, 0x000, 0x000, 0x000}, // 188
+    {0x000, 0x000, 0x004, 0x006, 0x004, 0x004, 0x064, 0x09e, 0x080, 0x060, 0x010, 0x0f0, 0x000, 0x000, 0x000, 0x000}, // 189
+    {0x000, 0x000, 0x00c, 0x012, 0x008, 0x010, 0x092, 0x0cc, 0x0a0, 0x090, 0x0b0, 0x0c0, 0x000, 0x000, 0x000, 0x000}, // 190
+    {0x000, 0x000, 0x010, 0x000, 0x010, 0x010, 0x008, 0x004, 0x002, 0x082, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 191
+    {0x004, 0x008, 0x010, 0x000, 0x038, 0x044, 0x082, 0x082, 0x0fe, 0x082, 0x082, 0x082, 0x000, 0x000, 0x000, 0x000}, // 192
+    {0x040, 0x020, 0x010, 0x000, 0x038, 0x044, 0x082, 0x082, 0x0fe, 0x082, 0x082, 0x082, 0x000, 0x000, 0x000, 0x000}, // 193
+    {0x010, 0x028, 0x044, 0x000, 0x038, 0x044, 0x082, 0x082, 0x0fe, 0x082, 0x082, 0x082, 0x000, 0x000, 0x000, 0x000}, // 194
+    {0x000, 0x08c, 0x072, 0x000, 0x038, 0x044, 0x082, 0x082, 0x0fe, 0x082, 0x082, 0x082, 0x000, 0x000, 0x000, 0x000}, // 195
+    {0x000, 0x044, 0x044, 0x000, 0x038, 0x044, 0x082, 0x082, 0x0fe, 0x082, 0x082, 0x082, 0x000, 0x000, 0x000, 0x000}, // 196
+    {0x000, 0x038, 0x044, 0x038, 0x028, 0x044, 0x082, 0x082, 0x0fe, 0x082, 0x082, 0x082, 0x000, 0x000, 0x000, 0x000}, // 197
+    {0x000, 0x000, 0x0ec, 0x012, 0x012, 0x012, 0x012, 0x07e, 0x012, 0x012, 0x012, 0x0f2, 0x000, 0x000, 0x000, 0x000}, // 198
+    {0x000, 0x000, 0x07c, 0x082, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x082, 0x07c, 0x030, 0x024, 0x018, 0x000}, // 199
+    {0x004, 0x008, 0x010, 0x000, 0x0fe, 0x004, 0x004, 0x03c, 0x004, 0x004, 0x004, 0x0fe, 0x000, 0x000, 0x000, 0x000}, // 200
+    {0x040, 0x020, 0x010, 0x000, 0x0fe, 0x004, 0x004, 0x03c, 0x004, 0x004, 0x004, 0x0fe, 0x000, 0x000, 0x000, 0x000}, // 201
+    {0x010, 0x028, 0x044, 0x000, 0x0fe, 0x004, 0x004, 0x03c, 0x004, 0x004, 0x004, 0x0fe, 0x000, 0x000, 0x000, 0x000}, // 202
+    {0x000, 0x044, 0x044, 0x000, 0x0fe, 0x004, 0x004, 0x03c, 0x004, 0x004, 0x004, 0x0fe, 0x000, 0x000, 0x000, 0x000}, // 203
+    {0x004, 0x008, 0x010, 0x000, 0x07c, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 204
+    {0x040, 0x020, 0x010, 0x000, 0x07c, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 205
+    {0x010, 0x028, 0x044, 0x000, 0x07c, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 206
+    {0x000, 0x044, 0x044, 0x000, 0x07c, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 207
+    {0x000, 0x000, 0x03e, 0x084, 0x084, 0x084, 0x087, 0x084, 0x084, 0x084, 0x084, 0x03e, 0x000, 0x000, 0x000, 0x000}, // 208
+    {0x000, 0x08c, 0x072, 0x000, 0x082, 0x086, 0x08a, 0x092, 0x092, 0x0a2, 0x0c2, 0x082, 0x000, 0x000, 0x000, 0x000}, // 209
+    {0x004, 0x008, 0x010, 0x000, 0x07c, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 210
+    {0x040, 0x020, 0x010, 0x000, 0x07c, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 211
+    {0x010, 0x028, 0x044, 0x000, 0x07c, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 212
+    {0x000, 0x08c, 0x072, 0x000, 0x07c, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 213
+    {0x000, 0x044, 0x044, 0x000, 0x07c, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 214
+    {0x000, 0x000, 0x000, 0x000, 0x082, 0x044, 0x028, 0x010, 0x028, 0x044, 0x082, 0x000, 0x000, 0x000, 0x000, 0x000}, // 215
+    {0x000, 0x080, 0x07c, 0x0c2, 0x0a2, 0x0a2, 0x092, 0x092, 0x08a, 0x08a, 0x086, 0x07c, 0x002, 0x000, 0x000, 0x000}, // 216
+    {0x004, 0x008, 0x010, 0x000, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 217
+    {0x040, 0x020, 0x010, 0x000, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 218
+    {0x010, 0x028, 0x044, 0x000, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 219
+    {0x000, 0x044, 0x044, 0x000, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 220
+    {0x040, 0x020, 0x010, 0x000, 0x082, 0x082, 0x044, 0x028, 0x010, 0x010, 0x010, 0x010, 0x000, 0x000, 0x000, 0x000}, // 221
+    {0x000, 0x000, 0x002, 0x002, 0x07e, 0x082, 0x082, 0x082, 0x07e, 0x002, 0x002, 0x002, 0x000, 0x000, 0x000, 0x000}, // 222
+    {0x000, 0x000, 0x038, 0x044, 0x044, 0x024, 0x016, 0x024, 0x044, 0x044, 0x044, 0x034, 0x000, 0x000, 0x000, 0x000}, // 223
+    {0x000, 0x008, 0x010, 0x020, 0x000, 0x07c, 0x080, 0x080, 0x0fc, 0x082, 0x0c2, 0x0bc, 0x000, 0x000, 0x000, 0x000}, // 224
+    {0x000, 0x040, 0x020, 0x010, 0x000, 0x07c, 0x080, 0x080, 0x0fc, 0x082, 0x0c2, 0x0bc, 0x000, 0x000, 0x000, 0x000}, // 225
+    {0x000, 0x010, 0x028, 0x044, 0x000, 0x07c, 0x080, 0x080, 0x0fc, 0x082, 0x0c2, 0x0bc, 0x000, 0x000, 0x000, 0x000}, // 226
+    {0x000, 0x000, 0x098, 0x064, 0x000, 0x07c, 0x080, 0x080, 0x0fc, 0x082, 0x0c2, 0x0bc, 0x000, 0x000, 0x000, 0x000}, // 227
+    {0x000, 0x000, 0x044, 0x044, 0x000, 0x07c, 0x080, 0x080, 0x0fc, 0x082, 0x0c2, 0x0bc, 0x000, 0x000, 0x000, 0x000}, // 228
+    {0x000, 0x030, 0x048, 0x030, 0x000, 0x07c, 0x080, 0x080, 0x0fc, 0x082, 0x0c2, 0x0bc, 0x000, 0x000, 0x000, 0x000}, // 229
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x06c, 0x092, 0x090, 0x07c, 0x012, 0x092, 0x0ec, 0x000, 0x000, 0x000, 0x000}, // 230
+    {0x000, 0x000, 0x000, 0x000, 0x000, 0x07c, 0x082, 0x002, 0x002, 0x002, 0x082, 0x07c, 0x030, 0x024, 0x018, 0x000}, // 231
+    {0x000, 0x004, 0x008, 0x010, 0x000, 0x07c, 0x082, 0x082, 0x0fe, 0x002, 0x002, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 232
+    {0x000, 0x040, 0x020, 0x010, 0x000, 0x07c, 0x082, 0x082, 0x0fe, 0x002, 0x002, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 233
+    {0x000, 0x010, 0x028, 0x044, 0x000, 0x07c, 0x082, 0x082, 0x0fe, 0x002, 0x002, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 234
+    {0x000, 0x000, 0x044, 0x044, 0x000, 0x07c, 0x082, 0x082, 0x0fe, 0x002, 0x002, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 235
+    {0x000, 0x004, 0x008, 0x010, 0x000, 0x01c, 0x010, 0x010, 0x010, 0x010, 0x010, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 236
+    {0x000, 0x020, 0x010, 0x008, 0x000, 0x01c, 0x010, 0x010, 0x010, 0x010, 0x010, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 237
+    {0x000, 0x008, 0x014, 0x022, 0x000, 0x01c, 0x010, 0x010, 0x010, 0x010, 0x010, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 238
+    {0x000, 0x000, 0x024, 0x024, 0x000, 0x01c, 0x010, 0x010, 0x010, 0x010, 0x010, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 239
+    {0x000, 0x024, 0x018, 0x014, 0x020, 0x07c, 0x082, 0x082, 0x082, 0x082, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 240
+    {0x000, 0x000, 0x08c, 0x072, 0x000, 0x07a, 0x086, 0x082, 0x082, 0x082, 0x082, 0x082, 0x000, 0x000, 0x000, 0x000}, // 241
+    {0x000, 0x004, 0x008, 0x010, 0x000, 0x07c, 0x082, 0x082, 0x082, 0x082, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 242
+    {0x000, 0x040, 0x020, 0x010, 0x000, 0x07c, 0x082, 0x082, 0x082, 0x082, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 243
+    {0x000, 0x010, 0x028, 0x044, 0x000, 0x07c, 0x082, 0x082, 0x082, 0x082, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 244
+    {0x000, 0x000, 0x08c, 0x072, 0x000, 0x07c, 0x082, 0x082, 0x082, 0x082, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 245
+    {0x000, 0x000, 0x044, 0x044, 0x000, 0x07c, 0x082, 0x082, 0x082, 0x082, 0x082, 0x07c, 0x000, 0x000, 0x000, 0x000}, // 246
+    {0x000, 0x000, 0x000, 0x010, 0x038, 0x010, 0x000, 0x0fe, 0x000, 0x010, 0x038, 0x010, 0x000, 0x000, 0x000, 0x000}, // 247
+    {0x000, 0x000, 0x000, 0x000, 0x080, 0x07c, 0x0a2, 0x0a2, 0x092, 0x08a, 0x08a, 0x07c, 0x002, 0x000, 0x000, 0x000}, // 248
+    {0x000, 0x004, 0x008, 0x010, 0x000, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x0bc, 0x000, 0x000, 0x000, 0x000}, // 249
+    {0x000, 0x040, 0x020, 0x010, 0x000, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x0bc, 0x000, 0x000, 0x000, 0x000}, // 250
+    {0x000, 0x010, 0x028, 0x044, 0x000, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x0bc, 0x000, 0x000, 0x000, 0x000}, // 251
+    {0x000, 0x000, 0x024, 0x024, 0x000, 0x042, 0x042, 0x042, 0x042, 0x042, 0x042, 0x0bc, 0x000, 0x000, 0x000, 0x000}, // 252
+    {0x000, 0x020, 0x010, 0x008, 0x000, 0x042, 0x042, 0x042, 0x042, 0x042, 0x062, 0x05c, 0x040, 0x042, 0x03c, 0x000}, // 253
+    {0x000, 0x000, 0x000, 0x002, 0x002, 0x002, 0x07a, 0x086, 0x082, 0x082, 0x086, 0x07a, 0x002, 0x002, 0x002, 0x000}, // 254
+    {0x000, 0x000, 0x024, 0x024, 0x000, 0x042, 0x042, 0x042, 0x042, 0x042, 0x062, 0x05c, 0x040, 0x042, 0x03c, 0x000}, // 255
+};
+} // namespace font
+} // namespace gk
@@ -0,0 +1,27 @@
+#ifndef _GK_FONT_H_
+#define _GK_FONT_H_
+
+#include <cstdint>
+
+namespace gk
+{
+namespace font
+{
+/** Number of pixel rows in each glyph bitmap */
+const int GLYPH_HEIGHT = 16;
+
+/** Offset in pixels from the top of a grid cell to the first row of its glyph.
+ *  Glyphs are taller than a row and bleed into the one below, exactly as
+ *  glutBitmapCharacter places them.
+ */
+const int GLYPH_TOP = 3;
+
+/** The 9x15 fixed font used by GLUT_BITMAP_9_BY_15. Each glyph is stored
+ *  top to bottom, one 9-bit mask per pixel row, where bit x is set if the
+ *  pixel in column x is lit.
+ */
+extern const std::uint16_t GLYPHS[256][GLYPH_HEIGHT];
+} // namespace font
+} // namespace gk
+
+#endif
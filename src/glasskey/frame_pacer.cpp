@@ -0,0 +1,121 @@
+#include "glasskey/glasskey.h"
+#include "glasskey/render_stats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace
+{
+// Sleeping is only trusted to wake up within this margin of a deadline, so
+// the last stretch before it is spent spinning
+const std::chrono::microseconds SPIN_MARGIN(1500);
+} // namespace
+
+namespace gk
+{
+FramePacer::FramePacer(float frames_per_second)
+{
+    set_rate(frames_per_second);
+    reset();
+}
+
+void FramePacer::set_rate(float frames_per_second)
+{
+    m_rate = frames_per_second;
+    m_period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / frames_per_second));
+}
+
+float FramePacer::rate() const
+{
+    return m_rate;
+}
+
+void FramePacer::reset()
+{
+    m_is_started = false;
+    m_frames = 0;
+    m_missed_deadlines = 0;
+    m_total_jitter = 0;
+    m_max_jitter = 0;
+}
+
+void FramePacer::wait()
+{
+    auto now = Clock::now();
+    if (!m_is_started)
+    {
+        m_is_started = true;
+        m_start = now;
+        m_last_frame = now;
+        m_deadline = now;
+    }
+
+    m_deadline += m_period;
+    if (now > m_deadline)
+    {
+        ++m_missed_deadlines;
+        if (now - m_deadline > m_period)
+        {
+            m_deadline = now;
+        }
+    }
+    else
+    {
+        if (m_deadline - now > SPIN_MARGIN)
+        {
+            std::this_thread::sleep_until(m_deadline - SPIN_MARGIN);
+        }
+
+        while ((now = Clock::now()) < m_deadline)
+        {
+            std::this_thread::yield();
+        }
+
+        if (stats_counters().is_timing.load(std::memory_order_relaxed))
+        {
+            stats_counters().oversleep.add(now - m_deadline);
+        }
+    }
+
+    double interval = std::chrono::duration<double>(now - m_last_frame).count();
+    double jitter = std::abs(interval - std::chrono::duration<double>(m_period).count());
+    m_total_jitter += jitter;
+    m_max_jitter = std::max(m_max_jitter, jitter);
+    m_last_frame = now;
+    ++m_frames;
+}
+
+FramePacerStats FramePacer::stats() const
+{
+    FramePacerStats stats = {m_frames, m_missed_deadlines, 0, m_max_jitter, 0};
+    if (m_frames)
+    {
+        stats.mean_jitter = m_total_jitter / m_frames;
+        double elapsed = std::chrono::duration<double>(m_last_frame - m_start).count();
+        if (elapsed > 0)
+        {
+            stats.effective_fps = m_frames / elapsed;
+        }
+    }
+
+    return stats;
+}
+
+FramePacer &frame_pacer()
+{
+    thread_local FramePacer pacer;
+    return pacer;
+}
+
+void next_frame(float frames_per_second)
+{
+    FramePacer &pacer = frame_pacer();
+    if (pacer.rate() != frames_per_second)
+    {
+        pacer.set_rate(frames_per_second);
+    }
+
+    pacer.wait();
+}
+} // namespace gk
@@ -0,0 +1,303 @@
+#include "glasskey/frame_recorder.h"
+#include "glasskey/recording.h"
+#include "glasskey/render_stats.h"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+namespace
+{
+// Unchanged cells between two runs are written rather than starting a new
+// run when that is no larger
+const std::size_t MAX_RUN_GAP = gk::recording::RUN_HEADER_SIZE / gk::recording::CELL_SIZE;
+
+// Frames waiting to be written beyond this are skipped, so that a slow disk
+// cannot make the recording hold more and more memory
+const std::size_t MAX_PENDING_FRAMES = 120;
+
+bool is_same(const gk::Cell &lhs, const gk::Cell &rhs)
+{
+    return lhs.value == rhs.value && lhs.color == rhs.color;
+}
+} // namespace
+
+namespace gk
+{
+FrameRecorder::FrameRecorder(const std::string &path, Size rows, Size cols, std::uint32_t keyframe_interval) : m_path(path),
+                                                                                                               m_rows(rows),
+                                                                                                               m_cols(cols),
+                                                                                                               m_keyframe_interval(std::max<std::uint32_t>(keyframe_interval, 1)),
+                                                                                                               m_start(std::chrono::steady_clock::now()),
+                                                                                                               m_version(0),
+                                                                                                               m_palette_version(0),
+                                                                                                               m_file(path, std::ios::binary | std::ios::trunc),
+                                                                                                               m_moved(rows, false),
+                                                                                                               m_is_stopping(false),
+                                                                                                               m_has_failed(false),
+                                                                                                               m_previous(static_cast<std::size_t>(rows) * cols),
+                                                                                                               m_frames(0),
+                                                                                                               m_last_time(0),
+                                                                                                               m_offset(0)
+{
+    if (!m_file)
+    {
+        throw std::runtime_error("Unable to open " + path + " for recording");
+    }
+
+    m_buffer.insert(m_buffer.end(), std::begin(recording::MAGIC), std::end(recording::MAGIC));
+    recording::put<std::uint16_t>(m_buffer, recording::VERSION);
+    recording::put<std::uint16_t>(m_buffer, rows);
+    recording::put<std::uint16_t>(m_buffer, cols);
+    recording::put<std::uint16_t>(m_buffer, 0);
+    recording::put<std::uint32_t>(m_buffer, m_keyframe_interval);
+    flush_buffer();
+    if (m_has_failed)
+    {
+        throw std::runtime_error("Unable to write the recording to " + m_path);
+    }
+
+    m_thread = std::thread(&FrameRecorder::run, this);
+}
+
+FrameRecorder::~FrameRecorder()
+{
+    stop();
+}
+
+void FrameRecorder::finish()
+{
+    stop();
+    if (m_has_failed)
+    {
+        throw std::runtime_error("Unable to write the recording to " + m_path);
+    }
+}
+
+void FrameRecorder::stop()
+{
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_is_stopping = true;
+    }
+
+    m_is_ready.notify_one();
+    m_thread.join();
+}
+
+void FrameRecorder::record(const FrameView &frame, std::uint64_t palette_version)
+{
+    Capture capture;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if (m_pending.size() >= MAX_PENDING_FRAMES)
+        {
+            // m_version is left as it was, so the next frame holds these rows too
+            add_count(stats_counters().frames_not_recorded);
+            return;
+        }
+
+        if (!m_spare.empty())
+        {
+            capture = std::move(m_spare.back());
+            m_spare.pop_back();
+        }
+    }
+
+    capture.time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count();
+    capture.rows.clear();
+    capture.cells.clear();
+
+    // scrolled rows keep their versions, but are still at new positions
+    std::fill(m_moved.begin(), m_moved.end(), false);
+    mark_shifted_rows(frame, m_version, m_moved);
+    for (Size row = 0; row < m_rows; ++row)
+    {
+        if (frame.row_versions[row] > m_version || m_moved[row])
+        {
+            const Cell *first = frame.cells + static_cast<std::size_t>(row) * m_cols;
+            capture.rows.push_back(row);
+            capture.cells.insert(capture.cells.end(), first, first + m_cols);
+        }
+    }
+
+    capture.has_palette = palette_version != m_palette_version || m_version == 0;
+    if (capture.has_palette)
+    {
+        capture.palette = *frame.palette;
+        m_palette_version = palette_version;
+    }
+
+    m_version = frame.version;
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_pending.push_back(std::move(capture));
+    }
+
+    m_is_ready.notify_one();
+}
+
+void FrameRecorder::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_is_ready.wait(lock, [this] { return m_is_stopping || !m_pending.empty(); });
+        if (m_pending.empty())
+        {
+            break;
+        }
+
+        Capture capture = std::move(m_pending.front());
+        m_pending.pop_front();
+        lock.unlock();
+
+        write(capture);
+
+        lock.lock();
+        m_spare.push_back(std::move(capture));
+    }
+
+    write_index();
+    m_file.close();
+    if (m_file.fail())
+    {
+        m_has_failed = true;
+    }
+}
+
+void FrameRecorder::write(const Capture &capture)
+{
+    if (capture.has_palette)
+    {
+        m_palette = capture.palette;
+    }
+
+    bool is_keyframe = m_frames % m_keyframe_interval == 0;
+    if (is_keyframe)
+    {
+        m_keyframes.push_back({m_frames, capture.time, m_offset});
+    }
+
+    if (capture.has_palette || is_keyframe)
+    {
+        recording::put<std::uint8_t>(m_buffer, recording::PALETTE);
+        recording::put<std::uint32_t>(m_buffer, static_cast<std::uint32_t>(m_palette.size()));
+        for (const Color &color : m_palette)
+        {
+            recording::put<std::uint32_t>(m_buffer, color.rgba());
+        }
+    }
+
+    m_last_time = capture.time;
+    recording::put<std::uint8_t>(m_buffer, is_keyframe ? recording::KEYFRAME : recording::DELTA);
+    recording::put<std::uint64_t>(m_buffer, capture.time);
+    recording::put<std::uint32_t>(m_buffer, m_frames);
+    ++m_frames;
+
+    if (is_keyframe)
+    {
+        for (std::size_t i = 0; i < capture.rows.size(); ++i)
+        {
+            const Cell *cells = capture.cells.data() + i * m_cols;
+            std::copy(cells, cells + m_cols, m_previous.begin() + static_cast<std::size_t>(capture.rows[i]) * m_cols);
+        }
+
+        write_cells(m_previous.data(), m_previous.data() + m_previous.size());
+    }
+    else
+    {
+        std::size_t count_offset = m_buffer.size();
+        recording::put<std::uint32_t>(m_buffer, 0);
+
+        std::uint32_t runs = 0;
+        for (std::size_t i = 0; i < capture.rows.size(); ++i)
+        {
+            const Cell *cells = capture.cells.data() + i * m_cols;
+            Cell *previous = m_previous.data() + static_cast<std::size_t>(capture.rows[i]) * m_cols;
+            Size col = 0;
+            while (col < m_cols)
+            {
+                if (is_same(cells[col], previous[col]))
+                {
+                    ++col;
+                    continue;
+                }
+
+                Size first = col;
+                Size last = col + 1;
+                for (col = last; col < m_cols && static_cast<std::size_t>(col - last) <= MAX_RUN_GAP; ++col)
+                {
+                    if (!is_same(cells[col], previous[col]))
+                    {
+                        last = col + 1;
+                    }
+                }
+
+                recording::put<std::uint16_t>(m_buffer, capture.rows[i]);
+                recording::put<std::uint16_t>(m_buffer, first);
+                recording::put<std::uint16_t>(m_buffer, last - first);
+                write_cells(cells + first, cells + last);
+                std::copy(cells + first, cells + last, previous + first);
+                col = last;
+                ++runs;
+            }
+        }
+
+        for (std::size_t i = 0; i < sizeof(std::uint32_t); ++i)
+        {
+            m_buffer[count_offset + i] = static_cast<char>((runs >> (8 * i)) & 0xFF);
+        }
+    }
+
+    flush_buffer();
+}
+
+void FrameRecorder::write_index()
+{
+    std::uint64_t index_offset = m_offset;
+    recording::put<std::uint8_t>(m_buffer, recording::INDEX);
+    recording::put<std::uint32_t>(m_buffer, m_frames);
+    recording::put<std::uint64_t>(m_buffer, m_last_time);
+    recording::put<std::uint32_t>(m_buffer, static_cast<std::uint32_t>(m_keyframes.size()));
+    for (const Keyframe &keyframe : m_keyframes)
+    {
+        recording::put<std::uint32_t>(m_buffer, keyframe.frame);
+        recording::put<std::uint64_t>(m_buffer, keyframe.time);
+        recording::put<std::uint64_t>(m_buffer, keyframe.offset);
+    }
+
+    recording::put<std::uint64_t>(m_buffer, index_offset);
+    m_buffer.insert(m_buffer.end(), recording::INDEX_MAGIC, recording::INDEX_MAGIC + sizeof(recording::INDEX_MAGIC));
+    recording::put<std::uint32_t>(m_buffer, 0);
+    flush_buffer();
+}
+
+void FrameRecorder::flush_buffer()
+{
+    // after an error the rest of the recording is encoded but not written
+    if (!m_has_failed)
+    {
+        m_file.write(m_buffer.data(), m_buffer.size());
+        m_has_failed = m_file.fail();
+    }
+
+    m_offset += m_buffer.size();
+    m_buffer.clear();
+}
+
+void FrameRecorder::write_cells(const Cell *first, const Cell *last)
+{
+    for (; first < last; ++first)
+    {
+        recording::put<std::uint8_t>(m_buffer, static_cast<std::uint8_t>(first->value));
+        recording::put<std::uint16_t>(m_buffer, first->color);
+    }
+}
+} // namespace gk
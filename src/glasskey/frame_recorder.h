@@ -0,0 +1,104 @@
+#ifndef _GK_FRAME_RECORDER_H_
+#define _GK_FRAME_RECORDER_H_
+
+#include "glasskey/frame_renderer.h"
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <thread>
+
+namespace gk
+{
+/** Writes the frames blitted by a TextGrid to a file in the format described
+ *  in recording.h. The producer only copies the rows which have changed since
+ *  the previous frame; comparing cells, encoding and writing all happen on a
+ *  background thread.
+ */
+class FrameRecorder
+{
+public:
+    /** Constructor. Throws std::runtime_error if the file cannot be opened.
+     *
+     *  \param path the path of the file to write
+     *  \param rows the number of rows in the grid
+     *  \param cols the number of columns in the grid
+     *  \param keyframe_interval the number of frames between keyframes
+     */
+    FrameRecorder(const std::string &path, Size rows, Size cols, std::uint32_t keyframe_interval);
+
+    /** Destructor. Calls finish() if it has not been called, ignoring errors. */
+    ~FrameRecorder();
+
+    /** Queues a frame to be written. Must be called with the grid locked. If
+     *  the writer has fallen too far behind the frame is skipped, and the
+     *  rows it changed are recorded with the next frame instead.
+     *
+     *  \param frame the frame being published by the grid
+     *  \param palette_version the version of the palette of the frame
+     */
+    void record(const FrameView &frame, std::uint64_t palette_version);
+
+    /** Waits for all recorded frames to be written, appends the keyframe
+     *  index and closes the file. Throws std::runtime_error if any part of
+     *  the recording could not be written, e.g. because the disk is full.
+     */
+    void finish();
+
+private:
+    /** The parts of a frame which changed since the previous one */
+    struct Capture
+    {
+        std::uint64_t time;
+        std::vector<Size> rows;
+        CellBuffer cells;
+        bool has_palette;
+        std::vector<Color> palette;
+    };
+
+    /** The location of a keyframe in the file */
+    struct Keyframe
+    {
+        std::uint32_t frame;
+        std::uint64_t time;
+        std::uint64_t offset;
+    };
+
+    void run();
+    void stop();
+    void write(const Capture &capture);
+    void write_cells(const Cell *first, const Cell *last);
+    void write_index();
+    void flush_buffer();
+
+    const std::string m_path;
+    const Size m_rows;
+    const Size m_cols;
+    const std::uint32_t m_keyframe_interval;
+    const std::chrono::steady_clock::time_point m_start;
+    std::uint64_t m_version;
+    std::uint64_t m_palette_version;
+    std::ofstream m_file;
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_is_ready;
+    std::deque<Capture> m_pending;
+    std::vector<Capture> m_spare;
+    std::vector<bool> m_moved;
+    bool m_is_stopping;
+
+    // set by the writer thread, and read once it has been joined
+    bool m_has_failed;
+
+    // only used by the writer thread
+    CellBuffer m_previous;
+    std::vector<Color> m_palette;
+    std::uint32_t m_frames;
+    std::uint64_t m_last_time;
+    std::uint64_t m_offset;
+    std::vector<Keyframe> m_keyframes;
+    std::vector<char> m_buffer;
+};
+} // namespace gk
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef _GK_FRAME_RENDERER_H_
+#define _GK_FRAME_RENDERER_H_
+
+#include "glasskey/glasskey.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace gk
+{
+/** A read-only view of a frame published by TextGrid::blit() */
+struct FrameView
+{
+    /** The number of rows in the frame */
+    Size rows;
+
+    /** The number of columns in the frame */
+    Size cols;
+
+    /** The cells of the frame in row-major order */
+    const Cell *cells;
+
+    /** The palette used to resolve the cell colors */
+    const std::vector<Color> *palette;
+
+    /** The grid version at which each row was last modified */
+    const std::uint64_t *row_versions;
+
+    /** The version of the grid captured in the frame */
+    std::uint64_t version;
+
+    /** The most recent row shifts made by TextGrid::scroll(), oldest first.
+     *  The rows of a shifted region keep their versions as they move.
+     */
+    const RowShift *shifts;
+
+    /** The number of row shifts */
+    std::size_t shift_count;
+
+    /** Every shift made after this version is included in shifts */
+    std::uint64_t shift_floor;
+};
+
+/** Moves the rows of a row-major buffer in the same way as a shift moved the
+ *  rows of the grid. The rows the shift exposed are left as they were.
+ *
+ *  \param data the buffer, holding row_size elements per grid row
+ *  \param row_size the number of elements per grid row
+ *  \param shift the shift to apply
+ */
+template <typename T>
+void shift_rows(T *data, std::size_t row_size, const RowShift &shift)
+{
+    Index height = shift.bottom - shift.top;
+    if (shift.rows == 0 || std::abs(shift.rows) >= height)
+    {
+        return;
+    }
+
+    T *top = data + static_cast<std::size_t>(shift.top) * row_size;
+    T *bottom = data + static_cast<std::size_t>(shift.bottom) * row_size;
+    std::size_t distance = static_cast<std::size_t>(std::abs(shift.rows)) * row_size;
+    if (shift.rows < 0)
+    {
+        std::copy(top + distance, bottom, top);
+    }
+    else
+    {
+        std::copy_backward(top, bottom - distance, bottom);
+    }
+}
+
+/** Brings a copy of an earlier frame up to date with the shifts made since,
+ *  so that only the rows with newer versions need to be redrawn into it.
+ *
+ *  \param frame the frame being drawn
+ *  \param version the version of the frame the buffer holds
+ *  \param data the buffer, holding row_size elements per grid row
+ *  \param row_size the number of elements per grid row
+ *  \return false if some of the shifts are no longer known, in which case
+ *          the whole buffer must be redrawn
+ */
+template <typename T>
+bool replay_shifts(const FrameView &frame, std::uint64_t version, T *data, std::size_t row_size)
+{
+    if (version < frame.shift_floor)
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < frame.shift_count; ++i)
+    {
+        if (frame.shifts[i].version > version)
+        {
+            shift_rows(data, row_size, frame.shifts[i]);
+        }
+    }
+
+    return true;
+}
+
+/** Marks the rows whose contents were moved by the shifts made since a
+ *  version, for use by anything which redraws rather than moves them.
+ *
+ *  \param frame the frame being drawn
+ *  \param version the version last drawn
+ *  \param moved set to true for each row which was moved
+ */
+inline void mark_shifted_rows(const FrameView &frame, std::uint64_t version, std::vector<bool> &moved)
+{
+    if (version < frame.shift_floor)
+    {
+        std::fill(moved.begin(), moved.end(), true);
+        return;
+    }
+
+    for (std::size_t i = 0; i < frame.shift_count; ++i)
+    {
+        const RowShift &shift = frame.shifts[i];
+        if (shift.version > version)
+        {
+            std::fill(moved.begin() + shift.top, moved.begin() + shift.bottom, true);
+        }
+    }
+}
+
+/** Interface for objects which draw the frames of a TextGrid */
+class FrameRenderer
+{
+public:
+    virtual ~FrameRenderer() = default;
+
+    /** Draws the rows of the frame which have changed since the last call.
+     *
+     *  \param frame the frame to draw
+     */
+    virtual void render(const FrameView &frame) = 0;
+};
+} // namespace gk
+
+#endif
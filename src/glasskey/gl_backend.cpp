@@ -0,0 +1,205 @@
+#include "glasskey/backend.h"
+#include "glasskey/gl_renderer.h"
+#include "glasskey/wakeup.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+#include <GL/freeglut_std.h>
+#include <GL/freeglut_ext.h>
+
+namespace
+{
+std::map<int, std::shared_ptr<gk::TextGrid>> g_grid_map;
+std::map<int, std::unique_ptr<gk::GlRenderer>> g_renderers;
+std::set<int> g_posted_redisplays;
+int g_start_x = 10;
+std::map<unsigned char, gk::Key> g_key_map = {
+    {32, gk::Key::SPACE},
+    {13, gk::Key::ENTER}
+};
+std::map<int, gk::Key> g_special_map = {
+    {GLUT_KEY_UP, gk::Key::UP},
+    {GLUT_KEY_DOWN, gk::Key::DOWN},
+    {GLUT_KEY_RIGHT, gk::Key::RIGHT},
+    {GLUT_KEY_LEFT, gk::Key::LEFT}
+};
+
+void set_orthographic_projection(int w, int h)
+{
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    gluOrtho2D(0, w, 0, h);
+    glScalef(1, -1, 1);
+    glTranslatef(0, static_cast<GLfloat>(-h), 0);
+    glMatrixMode(GL_MODELVIEW);
+}
+
+void reset_perspective_projection()
+{
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+}
+
+void resize(int width, int height)
+{
+    auto text_grid = g_grid_map[glutGetWindow()];
+    width = text_grid->cols() * gk::COL_WIDTH;
+    height = text_grid->rows() * gk::ROW_HEIGHT;
+    const float ar = (float)width / (float)height;
+    glViewport(0, 0, width, height);
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glFrustum(-ar, ar, -1.0, 1.0, 2.0, 100.0);
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+    if (g_renderers.count(glutGetWindow()))
+    {
+        g_renderers[glutGetWindow()]->invalidate();
+    }
+}
+
+template <typename Code>
+void add_key_event(const std::map<Code, gk::Key> &key_map, Code code, bool is_special, bool is_pressed)
+{
+    gk::KeyEvent event = {0, code, is_special, is_pressed, false, gk::Key::UP};
+    auto it = key_map.find(code);
+    if (it != key_map.end())
+    {
+        event.has_key = true;
+        event.key = it->second;
+    }
+
+    gk::add_key_event(event);
+}
+
+void keyboard(unsigned char key, int x, int y)
+{
+    add_key_event(g_key_map, key, false, true);
+}
+
+void keyboardup(unsigned char key, int x, int y)
+{
+    add_key_event(g_key_map, key, false, false);
+}
+
+void special(int key, int x, int y)
+{
+    add_key_event(g_special_map, key, true, true);
+}
+
+void specialup(int key, int x, int y)
+{
+    add_key_event(g_special_map, key, true, false);
+}
+
+void close()
+{
+    g_grid_map[glutGetWindow()]->id() = -1;
+    g_grid_map.erase(glutGetWindow());
+    g_renderers.erase(glutGetWindow());
+    g_posted_redisplays.erase(glutGetWindow());
+}
+} // namespace
+
+namespace gk
+{
+/** Backend which shows each grid in its own freeglut window */
+class GlBackend : public Backend
+{
+public:
+    void init(const std::vector<std::string> &args) override
+    {
+        int argc = static_cast<int>(args.size());
+        std::vector<char *> argv;
+        std::transform(args.begin(), args.end(), std::back_inserter(argv),
+                       [](const std::string &arg) -> char * { return const_cast<char *>(arg.c_str()); });
+        glutInit(&argc, argv.data());
+    }
+
+    void open(const std::shared_ptr<TextGrid> &text_grid) override
+    {
+        glutInitWindowSize(text_grid->cols() * COL_WIDTH, text_grid->rows() * ROW_HEIGHT);
+        glutInitWindowPosition(g_start_x, 10);
+        g_start_x += text_grid->cols() * COL_WIDTH;
+        glutInitDisplayMode(GLUT_RGB | GLUT_DOUBLE | GLUT_DEPTH);
+        glutSetOption(GLUT_ACTION_ON_WINDOW_CLOSE, GLUT_ACTION_CONTINUE_EXECUTION);
+        text_grid->id() = glutCreateWindow(text_grid->title().c_str());
+        glutReshapeFunc(resize);
+        glutDisplayFunc(display_grid);
+        glutKeyboardFunc(keyboard);
+        glutKeyboardUpFunc(keyboardup);
+        glutSpecialFunc(special);
+        glutSpecialUpFunc(specialup);
+        glutCloseFunc(::close);
+        g_grid_map[text_grid->id()] = text_grid;
+    }
+
+    void close(const std::shared_ptr<TextGrid> &text_grid) override
+    {
+        if (!g_grid_map.count(text_grid->id()))
+        {
+            return;
+        }
+
+        glutSetWindow(text_grid->id());
+        g_renderers.erase(text_grid->id());
+        g_posted_redisplays.erase(text_grid->id());
+        glutDestroyWindow(text_grid->id());
+        g_grid_map.erase(text_grid->id());
+    }
+
+    void update() override
+    {
+        for (auto &pair : g_grid_map)
+        {
+            if (pair.second->is_dirty())
+            {
+                glutSetWindow(pair.first);
+                glutPostRedisplay();
+                g_posted_redisplays.insert(pair.first);
+            }
+        }
+
+        glutMainLoopEvent();
+    }
+
+    void wait() override
+    {
+        render_thread_wakeup().wait(true);
+    }
+
+private:
+    static void display_grid()
+    {
+        auto text_grid = g_grid_map[glutGetWindow()];
+        auto &renderer = g_renderers[glutGetWindow()];
+        if (!renderer)
+        {
+            renderer = std::make_unique<GlRenderer>(text_grid->rows(), text_grid->cols());
+        }
+
+        // redisplays we did not ask for come from the window system, which
+        // may have discarded the window contents
+        if (g_posted_redisplays.erase(glutGetWindow()) == 0)
+        {
+            renderer->invalidate();
+        }
+
+        set_orthographic_projection(text_grid->cols() * COL_WIDTH, text_grid->rows() * ROW_HEIGHT);
+        glPushMatrix();
+        glLoadIdentity();
+        text_grid->draw_rows(*renderer);
+        glPopMatrix();
+        reset_perspective_projection();
+    }
+};
+
+std::unique_ptr<Backend> create_gl_backend()
+{
+    return std::make_unique<GlBackend>();
+}
+} // namespace gk
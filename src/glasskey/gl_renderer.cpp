@@ -0,0 +1,397 @@
+#include "glasskey/gl_renderer.h"
+#include "glasskey/font.h"
+#include "glasskey/render_stats.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+const int ATLAS_SIZE = 256;
+const int ATLAS_SLOT = 16;
+const int ATLAS_SLOTS_PER_ROW = ATLAS_SIZE / ATLAS_SLOT;
+const int VERTS_PER_CELL = 4;
+const GLuint OPAQUE = 0xFF000000u;
+
+// Glyphs extend this many pixels below the bottom of their row
+const int GLYPH_OVERHANG = gk::font::GLYPH_TOP + gk::font::GLYPH_HEIGHT - gk::ROW_HEIGHT;
+
+/** Textures before GL 2.0 must have power of two sizes */
+GLsizei texture_size(GLsizei size)
+{
+    GLsizei texture_size = 1;
+    while (texture_size < size)
+    {
+        texture_size *= 2;
+    }
+
+    return texture_size;
+}
+} // namespace
+
+namespace gk
+{
+GlRenderer::GlRenderer(Size rows, Size cols) : m_rows(rows),
+                                               m_cols(cols),
+                                               m_is_initialized(false),
+                                               m_use_atlas(false),
+                                               m_is_valid(false),
+                                               m_version(0),
+                                               m_damaged(rows, true),
+                                               m_atlas(0),
+                                               m_frame_texture(0),
+                                               m_frame_width(0),
+                                               m_frame_height(0)
+{
+}
+
+GlRenderer::~GlRenderer()
+{
+    if (m_atlas)
+    {
+        glDeleteTextures(1, &m_atlas);
+    }
+
+    if (m_frame_texture)
+    {
+        glDeleteTextures(1, &m_frame_texture);
+    }
+}
+
+bool GlRenderer::uses_atlas() const
+{
+    return m_use_atlas;
+}
+
+void GlRenderer::invalidate()
+{
+    m_is_valid = false;
+}
+
+void GlRenderer::initialize()
+{
+    m_is_initialized = true;
+
+    int major = 0;
+    int minor = 0;
+    const char *version = reinterpret_cast<const char *>(glGetString(GL_VERSION));
+    if (version == nullptr || std::sscanf(version, "%d.%d", &major, &minor) != 2)
+    {
+        return;
+    }
+
+    GLint max_texture_size = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size);
+    if (major == 1 && minor < 1)
+    {
+        return;
+    }
+
+    // without the frame texture every update redraws the whole window
+    create_frame_texture(max_texture_size);
+    if (max_texture_size < ATLAS_SIZE)
+    {
+        return;
+    }
+
+    m_use_atlas = create_atlas();
+    if (!m_use_atlas)
+    {
+        return;
+    }
+
+    std::size_t num_cells = static_cast<std::size_t>(m_rows) * m_cols;
+    m_positions.resize(num_cells * VERTS_PER_CELL * 2);
+    m_tex_coords.resize(num_cells * VERTS_PER_CELL * 2);
+    m_colors.resize(num_cells * VERTS_PER_CELL);
+
+    GLfloat *position = m_positions.data();
+    for (Size row = 0; row < m_rows; ++row)
+    {
+        GLfloat top = static_cast<GLfloat>(row * ROW_HEIGHT + font::GLYPH_TOP);
+        GLfloat bottom = top + font::GLYPH_HEIGHT;
+        for (Size col = 0; col < m_cols; ++col)
+        {
+            GLfloat left = static_cast<GLfloat>(col * COL_WIDTH);
+            GLfloat right = left + COL_WIDTH;
+            const GLfloat quad[] = {left, top, right, top, right, bottom, left, bottom};
+            position = std::copy(std::begin(quad), std::end(quad), position);
+        }
+    }
+}
+
+bool GlRenderer::create_atlas()
+{
+    std::vector<GLubyte> pixels(ATLAS_SIZE * ATLAS_SIZE, 0);
+    m_glyph_coords.resize(256 * VERTS_PER_CELL * 2);
+    for (int glyph = 0; glyph < 256; ++glyph)
+    {
+        int slot_left = (glyph % ATLAS_SLOTS_PER_ROW) * ATLAS_SLOT;
+        int slot_top = (glyph / ATLAS_SLOTS_PER_ROW) * ATLAS_SLOT;
+        for (int y = 0; y < font::GLYPH_HEIGHT; ++y)
+        {
+            GLubyte *line = pixels.data() + (slot_top + y) * ATLAS_SIZE + slot_left;
+            std::uint16_t mask = font::GLYPHS[glyph][y];
+            for (int x = 0; x < COL_WIDTH; ++x)
+            {
+                line[x] = (mask >> x) & 1 ? 255 : 0;
+            }
+        }
+
+        GLfloat u0 = static_cast<GLfloat>(slot_left) / ATLAS_SIZE;
+        GLfloat u1 = static_cast<GLfloat>(slot_left + COL_WIDTH) / ATLAS_SIZE;
+        GLfloat v0 = static_cast<GLfloat>(slot_top) / ATLAS_SIZE;
+        GLfloat v1 = static_cast<GLfloat>(slot_top + font::GLYPH_HEIGHT) / ATLAS_SIZE;
+        const GLfloat quad[] = {u0, v0, u1, v0, u1, v1, u0, v1};
+        std::copy(std::begin(quad), std::end(quad), m_glyph_coords.begin() + glyph * VERTS_PER_CELL * 2);
+    }
+
+    while (glGetError() != GL_NO_ERROR)
+    {
+    }
+
+    glGenTextures(1, &m_atlas);
+    glBindTexture(GL_TEXTURE_2D, m_atlas);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, ATLAS_SIZE, ATLAS_SIZE, 0, GL_ALPHA, GL_UNSIGNED_BYTE, pixels.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+    if (glGetError() != GL_NO_ERROR)
+    {
+        glDeleteTextures(1, &m_atlas);
+        m_atlas = 0;
+        return false;
+    }
+
+    return true;
+}
+
+bool GlRenderer::create_frame_texture(GLint max_texture_size)
+{
+    m_frame_width = texture_size(m_cols * COL_WIDTH);
+    m_frame_height = texture_size(m_rows * ROW_HEIGHT);
+    if (m_frame_width > max_texture_size || m_frame_height > max_texture_size)
+    {
+        return false;
+    }
+
+    while (glGetError() != GL_NO_ERROR)
+    {
+    }
+
+    glGenTextures(1, &m_frame_texture);
+    glBindTexture(GL_TEXTURE_2D, m_frame_texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, m_frame_width, m_frame_height, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    if (glGetError() != GL_NO_ERROR)
+    {
+        glDeleteTextures(1, &m_frame_texture);
+        m_frame_texture = 0;
+        return false;
+    }
+
+    return true;
+}
+
+void GlRenderer::draw_frame_texture()
+{
+    GLfloat width = static_cast<GLfloat>(m_cols * COL_WIDTH);
+    GLfloat height = static_cast<GLfloat>(m_rows * ROW_HEIGHT);
+    GLfloat u = width / m_frame_width;
+    GLfloat v = height / m_frame_height;
+
+    glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT | GL_CURRENT_BIT);
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, m_frame_texture);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+    glColor4f(1, 1, 1, 1);
+
+    // the texture holds the window bottom up, and the projection is top down
+    glBegin(GL_QUADS);
+    glTexCoord2f(0, v);
+    glVertex2f(0, 0);
+    glTexCoord2f(u, v);
+    glVertex2f(width, 0);
+    glTexCoord2f(u, 0);
+    glVertex2f(width, height);
+    glTexCoord2f(0, 0);
+    glVertex2f(0, height);
+    glEnd();
+
+    glPopAttrib();
+}
+
+void GlRenderer::copy_to_frame_texture(GLint top, GLint bottom)
+{
+    GLint height = m_rows * ROW_HEIGHT;
+    glBindTexture(GL_TEXTURE_2D, m_frame_texture);
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, height - bottom, 0, height - bottom, m_cols * COL_WIDTH, bottom - top);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void GlRenderer::render(const FrameView &frame)
+{
+    if (!m_is_initialized)
+    {
+        initialize();
+    }
+
+    const Cell *cells = frame.cells;
+    const std::vector<Color> &palette = *frame.palette;
+
+    // scrolled rows are redrawn, which only costs their quads on the GPU
+    std::fill(m_damaged.begin(), m_damaged.end(), false);
+    mark_shifted_rows(frame, m_version, m_damaged);
+
+    Size num_damaged = 0;
+    for (Size row = 0; row < m_rows; ++row)
+    {
+        m_damaged[row] = m_damaged[row] || !m_is_valid || frame.row_versions[row] > m_version;
+        if (m_damaged[row])
+        {
+            ++num_damaged;
+            if (m_use_atlas)
+            {
+                update_atlas(cells, palette, row);
+            }
+        }
+    }
+
+    m_version = frame.version;
+    if (num_damaged == 0)
+    {
+        return;
+    }
+
+    GLint height = m_rows * ROW_HEIGHT;
+    if (!m_is_valid || !m_frame_texture || num_damaged > m_rows / 2)
+    {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        draw_rows(cells, palette, 0, m_rows);
+        if (m_frame_texture)
+        {
+            copy_to_frame_texture(0, height);
+        }
+
+        PhaseTimer timer(stats_counters().present);
+        glutSwapBuffers();
+        m_is_valid = true;
+        return;
+    }
+
+    // the back buffer is undefined after a swap, so it starts as the last
+    // frame and only the damaged rows are drawn over it
+    glClear(GL_DEPTH_BUFFER_BIT);
+    draw_frame_texture();
+    glEnable(GL_SCISSOR_TEST);
+    for (Size row = 0; row < m_rows;)
+    {
+        if (!m_damaged[row])
+        {
+            ++row;
+            continue;
+        }
+
+        Size first_row = row;
+        while (row < m_rows && m_damaged[row])
+        {
+            ++row;
+        }
+
+        // the band covers the damaged rows plus the overhang of their glyphs
+        // into the next row, and the glyphs on either side which overlap it
+        GLint top = first_row * ROW_HEIGHT;
+        GLint bottom = std::min<GLint>(row * ROW_HEIGHT + GLYPH_OVERHANG, height);
+        glScissor(0, height - bottom, m_cols * COL_WIDTH, bottom - top);
+        glClear(GL_COLOR_BUFFER_BIT);
+        draw_rows(cells, palette, first_row > 0 ? first_row - 1 : 0, std::min<Size>(row + 1, m_rows));
+        copy_to_frame_texture(top, bottom);
+    }
+
+    glDisable(GL_SCISSOR_TEST);
+    PhaseTimer timer(stats_counters().present);
+    glutSwapBuffers();
+}
+
+void GlRenderer::draw_rows(const Cell *cells, const std::vector<Color> &palette, Size first_row, Size last_row)
+{
+    if (m_use_atlas)
+    {
+        draw_atlas(first_row, last_row);
+    }
+    else
+    {
+        draw_bitmaps(cells, palette, first_row, last_row);
+    }
+}
+
+void GlRenderer::update_atlas(const Cell *cells, const std::vector<Color> &palette, Size row)
+{
+    const std::size_t COORDS_PER_CELL = VERTS_PER_CELL * 2;
+    std::size_t first = static_cast<std::size_t>(row) * m_cols;
+    GLfloat *tex_coords = m_tex_coords.data() + first * COORDS_PER_CELL;
+    GLuint *colors = m_colors.data() + first * VERTS_PER_CELL;
+    const Cell *cell = cells + first;
+    for (Size col = 0; col < m_cols; ++col, ++cell)
+    {
+        const GLfloat *glyph = m_glyph_coords.data() + static_cast<std::uint8_t>(cell->value) * COORDS_PER_CELL;
+        std::memcpy(tex_coords, glyph, COORDS_PER_CELL * sizeof(GLfloat));
+        tex_coords += COORDS_PER_CELL;
+
+        GLuint color = palette[cell->color].rgba() | OPAQUE;
+        std::fill(colors, colors + VERTS_PER_CELL, color);
+        colors += VERTS_PER_CELL;
+    }
+}
+
+void GlRenderer::draw_atlas(Size first_row, Size last_row)
+{
+    GLint first = first_row * m_cols * VERTS_PER_CELL;
+    GLsizei count = (last_row - first_row) * m_cols * VERTS_PER_CELL;
+
+    glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT | GL_COLOR_BUFFER_BIT);
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, m_atlas);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    glEnable(GL_ALPHA_TEST);
+    glAlphaFunc(GL_GREATER, 0.5f);
+
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, m_positions.data());
+    glTexCoordPointer(2, GL_FLOAT, 0, m_tex_coords.data());
+    glColorPointer(4, GL_UNSIGNED_BYTE, 0, m_colors.data());
+    glDrawArrays(GL_QUADS, first, count);
+    glPopClientAttrib();
+
+    glPopAttrib();
+}
+
+void GlRenderer::draw_bitmaps(const Cell *cells, const std::vector<Color> &palette, Size first_row, Size last_row)
+{
+    const Cell *cell = cells + static_cast<std::size_t>(first_row) * m_cols;
+    float y = static_cast<float>((first_row + 1) * ROW_HEIGHT);
+    for (Size row = first_row; row < last_row; ++row, y += ROW_HEIGHT)
+    {
+        float x = 0;
+        for (Size col = 0; col < m_cols; ++col, ++cell, x += COL_WIDTH)
+        {
+            if (cell->value == ' ')
+            {
+                continue;
+            }
+
+            const Color &color = palette[cell->color];
+            glColor3f(color.red(), color.green(), color.blue());
+            glRasterPos2f(x, y);
+            glutBitmapCharacter(GLUT_BITMAP_9_BY_15, cell->value);
+        }
+    }
+}
+} // namespace gk
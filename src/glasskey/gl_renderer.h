@@ -0,0 +1,78 @@
+#ifndef _GK_GL_RENDERER_H_
+#define _GK_GL_RENDERER_H_
+
+#include "glasskey/frame_renderer.h"
+
+#include <GL/freeglut_std.h>
+
+namespace gk
+{
+/** Draws the cells of a TextGrid into the current GL context. Where the
+ *  context supports it the 9x15 font is rasterized once into a texture atlas
+ *  and the whole grid is drawn as a single batched array of textured quads,
+ *  with per-cell colors. Otherwise every glyph is drawn with its own call to
+ *  glutBitmapCharacter.
+ *
+ *  Only rows which have changed since the last presented frame are redrawn.
+ *  Every presented frame is kept in a texture, which restores the back
+ *  buffer after a swap so that small updates only draw their own rows,
+ *  scissored, before swapping. Large updates, or contexts which cannot hold
+ *  the frame in a texture, redraw the whole back buffer.
+ */
+class GlRenderer : public FrameRenderer
+{
+public:
+    /** Constructor.
+     *
+     *  \param rows the number of rows in the grid
+     *  \param cols the number of columns in the grid
+     */
+    GlRenderer(Size rows, Size cols);
+
+    /** Destructor. The GL context the renderer was used with must be current. */
+    ~GlRenderer();
+
+    /** Draws the changed rows to the current GL context and presents them.
+     *
+     *  \param frame the frame to draw
+     */
+    void render(const FrameView &frame) override;
+
+    /** Forces the next call to render() to redraw the entire window, e.g. because
+     *  the window system has discarded its contents.
+     */
+    void invalidate();
+
+    /** Whether the texture atlas is being used for rendering */
+    bool uses_atlas() const;
+
+private:
+    void initialize();
+    bool create_atlas();
+    bool create_frame_texture(GLint max_texture_size);
+    void draw_frame_texture();
+    void copy_to_frame_texture(GLint top, GLint bottom);
+    void update_atlas(const Cell *cells, const std::vector<Color> &palette, Size row);
+    void draw_atlas(Size first_row, Size last_row);
+    void draw_bitmaps(const Cell *cells, const std::vector<Color> &palette, Size first_row, Size last_row);
+    void draw_rows(const Cell *cells, const std::vector<Color> &palette, Size first_row, Size last_row);
+
+    const Size m_rows;
+    const Size m_cols;
+    bool m_is_initialized;
+    bool m_use_atlas;
+    bool m_is_valid;
+    std::uint64_t m_version;
+    std::vector<bool> m_damaged;
+    GLuint m_atlas;
+    GLuint m_frame_texture;
+    GLsizei m_frame_width;
+    GLsizei m_frame_height;
+    std::vector<GLfloat> m_glyph_coords;
+    std::vector<GLfloat> m_positions;
+    std::vector<GLfloat> m_tex_coords;
+    std::vector<GLuint> m_colors;
+};
+} // namespace gk
+
+#endif
@@ -1,38 +1,54 @@
 #include "glasskey/glasskey.h"
+#include "glasskey/backend.h"
+#include "glasskey/render_stats.h"
+#include "glasskey/wakeup.h"
 
 #include <algorithm>
 #include <atomic>
+#include <condition_variable>
 #include <iostream>
 #include <thread>
 #include <queue>
 
-#include <GL/freeglut_std.h>
-#include <GL/freeglut_ext.h>
-
-
 namespace
 {
-bool g_init = false;
 std::atomic_bool g_is_running = false;
 std::thread g_main_thread;
 std::mutex g_grid_mutex;
-std::map<int, std::shared_ptr<gk::TextGrid>> g_grid_map;
 std::queue<std::shared_ptr<gk::TextGrid>> g_to_create;
 std::queue<std::shared_ptr<gk::TextGrid>> g_to_destroy;
-std::chrono::time_point<std::chrono::system_clock> g_last_refresh_time;
-int g_start_x = 10;
-std::mutex g_pressed_mutex;
-std::map<gk::Key, bool> g_is_pressed;
-std::map<unsigned char, gk::Key> g_key_map = {
-    {32, gk::Key::SPACE},
-    {13, gk::Key::ENTER}
-};
-std::map<int, gk::Key> g_special_map = {
-    {GLUT_KEY_UP, gk::Key::UP},
-    {GLUT_KEY_DOWN, gk::Key::DOWN},
-    {GLUT_KEY_RIGHT, gk::Key::RIGHT},
-    {GLUT_KEY_LEFT, gk::Key::LEFT}
-};
+
+// guards the backend, which is created and initialized by whichever thread
+// gets there first and is then used from both the render and app threads
+std::mutex g_backend_mutex;
+std::condition_variable g_backend_ready;
+bool g_init = false;
+gk::BackendType g_backend_type = gk::BackendType::OPENGL;
+std::unique_ptr<gk::Backend> g_backend;
+
+/** Must be called with g_backend_mutex held */
+gk::Backend &get_backend()
+{
+    if (!g_backend)
+    {
+        switch (g_backend_type)
+        {
+        case gk::BackendType::HEADLESS:
+            g_backend = gk::create_headless_backend();
+            break;
+
+        case gk::BackendType::TERMINAL:
+            g_backend = gk::create_terminal_backend();
+            break;
+
+        default:
+            g_backend = gk::create_gl_backend();
+            break;
+        }
+    }
+
+    return *g_backend;
+}
 } // namespace
 
 namespace gk
@@ -58,16 +74,29 @@ std::ostream &operator<<(std::ostream &os, const TextGrid &grid)
     return os << grid.to_string();
 }
 
+void set_backend(BackendType backend)
+{
+    std::lock_guard<std::mutex> guard(g_backend_mutex);
+    if (!g_init && !g_backend)
+    {
+        g_backend_type = backend;
+    }
+}
+
+BackendType backend()
+{
+    std::lock_guard<std::mutex> guard(g_backend_mutex);
+    return g_backend_type;
+}
+
 void init(const std::vector<std::string> &args)
 {
+    std::lock_guard<std::mutex> guard(g_backend_mutex);
     if (!g_init)
     {
-        int argc = static_cast<int>(args.size());
-        std::vector<char *> argv;
-        std::transform(args.begin(), args.end(), std::back_inserter(argv),
-                       [](const std::string &arg) -> char * { return const_cast<char *>(arg.c_str()); });
-        glutInit(&argc, argv.data());
+        get_backend().init(args);
         g_init = true;
+        g_backend_ready.notify_all();
     }
 }
 
@@ -76,6 +105,7 @@ std::shared_ptr<TextGrid> create_grid(Size rows, Size cols, const std::string &t
     std::lock_guard<std::mutex> guard(g_grid_mutex);
     auto text_grid = std::make_shared<TextGrid>(TextGrid(rows, cols, title, default_color));
     g_to_create.push(text_grid);
+    render_thread_wakeup().notify();
     return text_grid;
 }
 
@@ -83,151 +113,67 @@ void destroy_grid(std::shared_ptr<TextGrid> text_grid)
 {
     std::lock_guard<std::mutex> guard(g_grid_mutex);
     g_to_destroy.push(text_grid);
+    render_thread_wakeup().notify();
 }
 
-void set_orthographic_projection(int w, int h)
-{
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    gluOrtho2D(0, w, 0, h);
-    glScalef(1, -1, 1);
-    glTranslatef(0, static_cast<GLfloat>(-h), 0);
-    glMatrixMode(GL_MODELVIEW);
-}
-
-void reset_perspective_projection()
-{
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-}
-
-void resize(int width, int height)
-{
-    auto text_grid = g_grid_map[glutGetWindow()];
-    width = text_grid->cols() * COL_WIDTH;
-    height = text_grid->rows() * ROW_HEIGHT;
-    const float ar = (float)width / (float)height;
-    glViewport(0, 0, width, height);
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    glFrustum(-ar, ar, -1.0, 1.0, 2.0, 100.0);
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
-}
-
-void display_grid()
-{
-    auto text_grid = g_grid_map[glutGetWindow()];
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    set_orthographic_projection(text_grid->cols() * COL_WIDTH, text_grid->rows() * ROW_HEIGHT);
-    glPushMatrix();
-    glLoadIdentity();
-    text_grid->draw_rows();
-    glPopMatrix();
-    reset_perspective_projection();
-    glutSwapBuffers();
-}
-
-void keyboard(unsigned char key, int x, int y)
-{
-    if(g_key_map.count(key)){
-        std::lock_guard<std::mutex> guard(g_pressed_mutex);
-        g_is_pressed[g_key_map[key]] = true;
-    }
-}
-
-void keyboardup(unsigned char key, int x, int y)
+bool read_pixels(const std::shared_ptr<TextGrid> &text_grid, Image &image)
 {
-    if(g_key_map.count(key)){
-        std::lock_guard<std::mutex> guard(g_pressed_mutex);
-        g_is_pressed[g_key_map[key]] = false;
+    Backend *backend = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(g_backend_mutex);
+        if (g_init)
+        {
+            backend = g_backend.get();
+        }
     }
-}
 
-void special(int key, int x, int y)
-{
-    if(g_special_map.count(key)){
-        std::lock_guard<std::mutex> guard(g_pressed_mutex);
-        g_is_pressed[g_special_map[key]] = true;
-    }
+    // once initialized the backend lives until the process exits
+    return backend != nullptr && backend->read_pixels(*text_grid, image);
 }
 
-void specialup(int key, int x, int y)
-{
-    if(g_special_map.count(key)){
-        std::lock_guard<std::mutex> guard(g_pressed_mutex);
-        g_is_pressed[g_special_map[key]] = false;
-    }    
-}
-
-bool is_pressed(Key key)
-{
-    std::lock_guard<std::mutex> guard(g_pressed_mutex);
-    return g_is_pressed[key];
-}
-
-void close()
-{
-    std::lock_guard<std::mutex> guard(g_grid_mutex);
-    g_grid_map[glutGetWindow()]->id() = -1;
-    g_grid_map.erase(glutGetWindow());
-}
-
-void create_and_destroy_grids()
+void create_and_destroy_grids(Backend &backend)
 {
     std::lock_guard<std::mutex> guard(g_grid_mutex);
     while (g_to_create.size())
     {
-        auto text_grid = g_to_create.front();
-        glutInitWindowSize(text_grid->cols() * COL_WIDTH, text_grid->rows() * ROW_HEIGHT);
-        glutInitWindowPosition(g_start_x, 10);
-        g_start_x += text_grid->cols() * COL_WIDTH;
-        glutInitDisplayMode(GLUT_RGB | GLUT_DOUBLE | GLUT_DEPTH);
-        glutSetOption(GLUT_ACTION_ON_WINDOW_CLOSE, GLUT_ACTION_CONTINUE_EXECUTION);
-        text_grid->id() = glutCreateWindow(text_grid->title().c_str());
-        glutReshapeFunc(resize);
-        glutDisplayFunc(display_grid);
-        glutKeyboardFunc(keyboard);
-        glutKeyboardUpFunc(keyboardup);
-        glutSpecialFunc(special);
-        glutSpecialUpFunc(specialup);
-        glutCloseFunc(close);
-        g_grid_map[text_grid->id()] = text_grid;
+        backend.open(g_to_create.front());
         g_to_create.pop();
     }
 
     while (g_to_destroy.size())
     {
-        auto text_grid = g_to_destroy.front();
-        glutDestroyWindow(text_grid->id());
-        g_grid_map.erase(text_grid->id());
+        backend.close(g_to_destroy.front());
         g_to_destroy.pop();
     }
 }
 
-void refresh_grids()
+void main_loop()
 {
-    for (auto &pair : g_grid_map)
+    init();
+    Backend *backend_ptr = nullptr;
     {
-        if (pair.second->is_dirty())
-        {
-            glutSetWindow(pair.first);
-            glutPostRedisplay();
-        }
+        std::lock_guard<std::mutex> guard(g_backend_mutex);
+        backend_ptr = g_backend.get();
     }
-}
 
-void main_loop()
-{
-    init();
-    auto lastFrameTime = std::chrono::system_clock::now();
+    Backend &backend = *backend_ptr;
+    Wakeup &wakeup = render_thread_wakeup();
     while (g_is_running.load())
     {
-        create_and_destroy_grids();
-        refresh_grids();
-        glutMainLoopEvent();
+        wakeup.reset();
+        {
+            PhaseTimer timer(stats_counters().update);
+            create_and_destroy_grids(backend);
+            backend.update();
+        }
+
+        if (g_is_running.load())
+        {
+            // sleep until a grid is blitted, created or destroyed, or
+            // until the backend has input or redisplays for us
+            PhaseTimer timer(stats_counters().idle);
+            backend.wait();
+        }
     }
 }
 
@@ -237,6 +183,10 @@ void start()
     {
         g_is_running.store(true);
         g_main_thread = std::thread(&main_loop);
+
+        // the render thread initializes the backend, which read_pixels() needs
+        std::unique_lock<std::mutex> lock(g_backend_mutex);
+        g_backend_ready.wait(lock, [] { return g_init; });
     }
 }
 
@@ -245,19 +195,9 @@ void stop()
     if (g_is_running.load())
     {
         g_is_running.store(false);
+        render_thread_wakeup().notify();
         g_main_thread.join();
     }
 }
 
-void next_frame(float frames_per_second)
-{
-    auto time_per_frame = std::chrono::milliseconds(static_cast<std::size_t>(1000.0f/frames_per_second));
-    auto duration = std::chrono::system_clock::now() - g_last_refresh_time;
-    if(duration < time_per_frame){
-        std::this_thread::sleep_for(time_per_frame - duration);
-    }
-
-    g_last_refresh_time = std::chrono::system_clock::now();
-}
-
-} // namespace gk
\ No newline at end of file
+} // namespace gk
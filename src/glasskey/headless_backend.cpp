@@ -0,0 +1,89 @@
+#include "glasskey/backend.h"
+#include "glasskey/cpu_renderer.h"
+#include "glasskey/wakeup.h"
+
+#include <map>
+
+namespace gk
+{
+/** Backend which rasterizes each grid into an in-memory image on the CPU.
+ *  Frames are rendered as soon as they are blitted, with no window system
+ *  or display refresh to wait on.
+ */
+class HeadlessBackend : public Backend
+{
+public:
+    HeadlessBackend() : m_next_id(1)
+    {
+    }
+
+    void init(const std::vector<std::string> & /*args*/) override
+    {
+    }
+
+    void open(const std::shared_ptr<TextGrid> &text_grid) override
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        text_grid->id() = m_next_id++;
+        m_grids[text_grid->id()] = text_grid;
+        m_renderers[text_grid->id()] = std::make_unique<CpuRenderer>(text_grid->rows(), text_grid->cols());
+    }
+
+    void close(const std::shared_ptr<TextGrid> &text_grid) override
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_grids.erase(text_grid->id());
+        m_renderers.erase(text_grid->id());
+    }
+
+    void update() override
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        for (auto &pair : m_grids)
+        {
+            if (pair.second->is_dirty())
+            {
+                pair.second->draw_rows(*m_renderers[pair.first]);
+            }
+        }
+    }
+
+    void wait() override
+    {
+        render_thread_wakeup().wait(false);
+    }
+
+    bool read_pixels(TextGrid &text_grid, Image &image) override
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        auto it = m_renderers.find(text_grid.id());
+        if (it == m_renderers.end())
+        {
+            // a grid which is not open, or has been closed, keeps no renderer
+            CpuRenderer grid_renderer(text_grid.rows(), text_grid.cols());
+            text_grid.draw_rows(grid_renderer);
+            image = grid_renderer.image();
+            return true;
+        }
+
+        if (text_grid.is_dirty())
+        {
+            text_grid.draw_rows(*it->second);
+        }
+
+        image = it->second->image();
+        return true;
+    }
+
+private:
+    std::mutex m_mutex;
+    int m_next_id;
+    std::map<int, std::shared_ptr<TextGrid>> m_grids;
+    std::map<int, std::unique_ptr<CpuRenderer>> m_renderers;
+};
+
+std::unique_ptr<Backend> create_headless_backend()
+{
+    return std::make_unique<HeadlessBackend>();
+}
+} // namespace gk
@@ -0,0 +1,184 @@
+#include "glasskey/backend.h"
+
+namespace
+{
+/** The number of codes tracked for each of character and special keys */
+const int KEY_CODES = 256;
+const int WORD_BITS = 64;
+
+/** The state of every key as one bit, so that polling is a single load */
+class KeyState
+{
+public:
+    void set(std::size_t bit, bool is_pressed)
+    {
+        std::uint64_t mask = std::uint64_t(1) << (bit % WORD_BITS);
+        if (is_pressed)
+        {
+            m_words[bit / WORD_BITS].fetch_or(mask, std::memory_order_release);
+        }
+        else
+        {
+            m_words[bit / WORD_BITS].fetch_and(~mask, std::memory_order_release);
+        }
+    }
+
+    bool get(std::size_t bit) const
+    {
+        return (m_words[bit / WORD_BITS].load(std::memory_order_acquire) >> (bit % WORD_BITS)) & 1;
+    }
+
+private:
+    std::atomic<std::uint64_t> m_words[2 * KEY_CODES / WORD_BITS] = {};
+};
+
+/** Bounded queue with one producer, the render thread, and any number of
+ *  consumers. Each slot carries a sequence number which says whether it holds
+ *  an event for the next consumer or is free for the producer, so neither
+ *  side ever waits for the other.
+ */
+class KeyEventQueue
+{
+public:
+    KeyEventQueue() : m_head(0),
+                      m_tail(0),
+                      m_dropped(0)
+    {
+        for (std::size_t i = 0; i < gk::KEY_EVENT_CAPACITY; ++i)
+        {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    void push(const gk::KeyEvent &event)
+    {
+        Slot &slot = m_slots[m_head % gk::KEY_EVENT_CAPACITY];
+        if (slot.sequence.load(std::memory_order_acquire) != m_head)
+        {
+            // the oldest event has not been drained yet
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        slot.event = event;
+        slot.sequence.store(m_head + 1, std::memory_order_release);
+        ++m_head;
+    }
+
+    bool pop(gk::KeyEvent &event)
+    {
+        std::uint64_t position = m_tail.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot &slot = m_slots[position % gk::KEY_EVENT_CAPACITY];
+            std::uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence != position + 1)
+            {
+                if (sequence < position + 1)
+                {
+                    return false;
+                }
+
+                // another consumer took this event first
+                position = m_tail.load(std::memory_order_relaxed);
+            }
+            else if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                event = slot.event;
+                slot.sequence.store(position + gk::KEY_EVENT_CAPACITY, std::memory_order_release);
+                return true;
+            }
+        }
+    }
+
+    std::uint64_t dropped() const
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<std::uint64_t> sequence;
+        gk::KeyEvent event;
+    };
+
+    Slot m_slots[gk::KEY_EVENT_CAPACITY];
+
+    // only touched by the producer
+    std::uint64_t m_head;
+    alignas(gk::CACHE_LINE_SIZE) std::atomic<std::uint64_t> m_tail;
+    std::atomic<std::uint64_t> m_dropped;
+};
+
+KeyState g_key_codes;
+std::atomic<std::uint32_t> g_keys{0};
+KeyEventQueue g_key_events;
+} // namespace
+
+namespace gk
+{
+void add_key_event(KeyEvent event)
+{
+    event.time = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    if (event.code >= 0 && event.code < KEY_CODES)
+    {
+        g_key_codes.set(event.code + (event.is_special ? KEY_CODES : 0), event.is_pressed);
+    }
+
+    if (event.has_key)
+    {
+        std::uint32_t mask = 1u << static_cast<int>(event.key);
+        if (event.is_pressed)
+        {
+            g_keys.fetch_or(mask, std::memory_order_release);
+        }
+        else
+        {
+            g_keys.fetch_and(~mask, std::memory_order_release);
+        }
+    }
+
+    g_key_events.push(event);
+}
+
+bool is_pressed(Key key)
+{
+    return (g_keys.load(std::memory_order_acquire) >> static_cast<int>(key)) & 1;
+}
+
+bool is_pressed(int code, bool is_special)
+{
+    if (code < 0 || code >= KEY_CODES)
+    {
+        return false;
+    }
+
+    return g_key_codes.get(code + (is_special ? KEY_CODES : 0));
+}
+
+std::size_t drain_key_events(std::vector<KeyEvent> &events)
+{
+    std::size_t count = 0;
+    KeyEvent event;
+    while (g_key_events.pop(event))
+    {
+        events.push_back(event);
+        ++count;
+    }
+
+    return count;
+}
+
+std::vector<KeyEvent> drain_key_events()
+{
+    std::vector<KeyEvent> events;
+    drain_key_events(events);
+    return events;
+}
+
+std::uint64_t dropped_key_events()
+{
+    return g_key_events.dropped();
+}
+} // namespace gk
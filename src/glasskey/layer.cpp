@@ -0,0 +1,104 @@
+#include "glasskey/glasskey.h"
+
+#include <stdexcept>
+
+namespace gk
+{
+Layer::Layer(TextGrid *text_grid) : m_text_grid(text_grid),
+                                    m_cells(static_cast<std::size_t>(text_grid->rows()) * text_grid->cols(), Cell{TRANSPARENT, 0})
+{
+}
+
+TextGrid &Layer::attached() const
+{
+    if (m_text_grid == nullptr)
+    {
+        throw std::runtime_error("The layer has been removed from its TextGrid");
+    }
+
+    return *m_text_grid;
+}
+
+Layer &Layer::draw(Index row, Index col, const std::string &values)
+{
+    TextGrid &text_grid = attached();
+    auto guard = text_grid.lock_rows();
+    text_grid.draw_text(m_cells.data(), row, col, values.data(), values.size());
+    return *this;
+}
+
+Layer &Layer::draw(Index row, Index col, const std::vector<Letter> &letters)
+{
+    TextGrid &text_grid = attached();
+    auto guard = text_grid.lock_rows();
+    text_grid.draw_letters(m_cells.data(), row, col, letters.data(), letters.size());
+    return *this;
+}
+
+Layer &Layer::draw(const Rect &rect, char value)
+{
+    TextGrid &text_grid = attached();
+    auto guard = text_grid.lock_rows();
+    text_grid.fill(m_cells.data(), rect, Cell{value, text_grid.get_color(value)});
+    return *this;
+}
+
+Layer &Layer::clear(Index row, Index col, Size cols)
+{
+    TextGrid &text_grid = attached();
+    auto guard = text_grid.lock_rows();
+    text_grid.clear_cells(m_cells.data(), row, col, cols, Cell{TRANSPARENT, 0});
+    return *this;
+}
+
+Layer &Layer::clear(const Rect &rect)
+{
+    TextGrid &text_grid = attached();
+    auto guard = text_grid.lock_rows();
+    text_grid.fill(m_cells.data(), rect, Cell{TRANSPARENT, 0});
+    return *this;
+}
+
+Layer &Layer::clear()
+{
+    TextGrid &text_grid = attached();
+    return clear(Rect(0, 0, text_grid.cols(), text_grid.rows()));
+}
+
+Layer &Layer::recolor(const Rect &rect)
+{
+    TextGrid &text_grid = attached();
+    auto guard = text_grid.lock_rows();
+    text_grid.recolor_cells(m_cells.data(), rect);
+    return *this;
+}
+
+Layer &Layer::scroll(const Rect &rect, Index rows, Index cols)
+{
+    TextGrid &text_grid = attached();
+    auto guard = text_grid.lock_rows();
+    text_grid.scroll_cells(m_cells.data(), rect, rows, cols, Cell{TRANSPARENT, 0});
+    return *this;
+}
+
+Layer &Layer::blit_sprite(const Sprite &sprite, Index row, Index col)
+{
+    TextGrid &text_grid = attached();
+    auto guard = text_grid.lock_rows();
+    text_grid.draw_sprite(m_cells.data(), sprite, row, col);
+    return *this;
+}
+
+Layer &Layer::apply(const DrawBatch &batch)
+{
+    TextGrid &text_grid = attached();
+    auto guard = text_grid.lock_rows();
+    text_grid.apply_batch(m_cells.data(), batch, Cell{TRANSPARENT, 0});
+    return *this;
+}
+
+bool Layer::is_attached() const
+{
+    return m_text_grid != nullptr;
+}
+} // namespace gk
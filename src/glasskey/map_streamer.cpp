@@ -0,0 +1,280 @@
+#include "glasskey/glasskey.h"
+#include "glasskey/mapped_file.h"
+#include "glasskey/tile_map.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+/** The number of tiles beyond the view which are loaded in the direction it moves */
+const std::int64_t PREFETCH_TILES = 2;
+
+const std::size_t TILE_CELLS = static_cast<std::size_t>(gk::WORLD_CHUNK_SIZE) * gk::WORLD_CHUNK_SIZE;
+
+int sign(std::int64_t value)
+{
+    return (value > 0) - (value < 0);
+}
+} // namespace
+
+namespace gk
+{
+MapStreamer::MapStreamer(const std::string &path, const std::shared_ptr<WorldGrid> &world,
+                         std::size_t max_tiles) : m_file(std::make_unique<MappedFile>(path)),
+                                                  m_world(world),
+                                                  m_max_tiles(max_tiles),
+                                                  m_top(0),
+                                                  m_left(0),
+                                                  m_has_view(false),
+                                                  m_is_stopping(false)
+{
+    const char *data = m_file->data();
+    std::size_t size = m_file->size();
+    bool is_valid = size >= tile_map::HEADER_SIZE &&
+                    std::equal(tile_map::MAGIC, tile_map::MAGIC + sizeof(tile_map::MAGIC), data) &&
+                    recording::get<std::uint16_t>(data + 4) == tile_map::VERSION &&
+                    recording::get<std::uint16_t>(data + 6) == WORLD_CHUNK_SIZE;
+    std::uint64_t index_offset = 0;
+    std::uint64_t palette_offset = 0;
+    if (is_valid)
+    {
+        m_rows = recording::get<std::uint32_t>(data + 8);
+        m_cols = recording::get<std::uint32_t>(data + 12);
+        m_tile_rows = static_cast<std::uint32_t>((static_cast<std::uint64_t>(m_rows) + WORLD_CHUNK_SIZE - 1) / WORLD_CHUNK_SIZE);
+        m_tile_cols = static_cast<std::uint32_t>((static_cast<std::uint64_t>(m_cols) + WORLD_CHUNK_SIZE - 1) / WORLD_CHUNK_SIZE);
+        index_offset = recording::get<std::uint64_t>(data + 16);
+        palette_offset = recording::get<std::uint64_t>(data + 24);
+        // the offsets come from the file, so they are compared before anything is added to them
+        is_valid = index_offset <= size &&
+                   static_cast<std::uint64_t>(m_tile_rows) * m_tile_cols * 8 <= size - index_offset &&
+                   palette_offset <= size - 4 &&
+                   static_cast<std::uint64_t>(recording::get<std::uint32_t>(data + palette_offset)) * 4 <= size - 4 - palette_offset;
+    }
+
+    if (!is_valid)
+    {
+        throw std::runtime_error(path + " is not a glasskey tile map");
+    }
+
+    m_index = data + index_offset;
+    std::uint32_t colors = recording::get<std::uint32_t>(data + palette_offset);
+    {
+        std::lock_guard<std::mutex> guard(m_world->m_mutex);
+        for (std::uint32_t i = 0; i < colors; ++i)
+        {
+            m_handles.push_back(m_world->intern_color(Color::from_rgba(recording::get<std::uint32_t>(data + palette_offset + 4 + i * 4))));
+        }
+    }
+
+    m_thread = std::thread(&MapStreamer::run, this);
+}
+
+MapStreamer::~MapStreamer()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_is_stopping = true;
+    }
+
+    m_work_ready.notify_one();
+    m_thread.join();
+}
+
+std::uint32_t MapStreamer::rows() const
+{
+    return m_rows;
+}
+
+std::uint32_t MapStreamer::cols() const
+{
+    return m_cols;
+}
+
+void MapStreamer::update(std::int32_t top, std::int32_t left, std::int32_t rows, std::int32_t cols)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    int row_direction = m_has_view ? sign(static_cast<std::int64_t>(top) - m_top) : 0;
+    int col_direction = m_has_view ? sign(static_cast<std::int64_t>(left) - m_left) : 0;
+    m_top = top;
+    m_left = left;
+    m_has_view = true;
+
+    // the tiles under the view, in tile coordinates [first, last)
+    std::int64_t first_row = static_cast<std::int64_t>(top) / WORLD_CHUNK_SIZE;
+    std::int64_t last_row = (static_cast<std::int64_t>(top) + std::max(rows, 0) + WORLD_CHUNK_SIZE - 1) / WORLD_CHUNK_SIZE;
+    std::int64_t first_col = static_cast<std::int64_t>(left) / WORLD_CHUNK_SIZE;
+    std::int64_t last_col = (static_cast<std::int64_t>(left) + std::max(cols, 0) + WORLD_CHUNK_SIZE - 1) / WORLD_CHUNK_SIZE;
+    if (top < 0)
+    {
+        first_row = 0;
+    }
+
+    if (left < 0)
+    {
+        first_col = 0;
+    }
+
+    // requests which the view has moved away from are dropped
+    m_requests.clear();
+    m_requested.clear();
+    m_visible.clear();
+    request(first_row, last_row, first_col, last_col);
+    m_visible = m_requested;
+    for (std::uint64_t key : m_visible)
+    {
+        auto it = m_loaded.find(key);
+        if (it != m_loaded.end())
+        {
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+        }
+    }
+
+    if (row_direction > 0)
+    {
+        request(last_row, last_row + PREFETCH_TILES, first_col, last_col);
+    }
+    else if (row_direction < 0)
+    {
+        request(first_row - PREFETCH_TILES, first_row, first_col, last_col);
+    }
+
+    if (col_direction > 0)
+    {
+        request(first_row, last_row, last_col, last_col + PREFETCH_TILES);
+    }
+    else if (col_direction < 0)
+    {
+        request(first_row, last_row, first_col - PREFETCH_TILES, first_col);
+    }
+
+    if (!m_requests.empty())
+    {
+        m_work_ready.notify_one();
+    }
+    else if (m_loading.empty())
+    {
+        m_idle.notify_all();
+    }
+}
+
+void MapStreamer::update(const Camera &camera)
+{
+    update(camera.row(), camera.col(), camera.rows(), camera.cols());
+}
+
+void MapStreamer::request(std::int64_t first_row, std::int64_t last_row, std::int64_t first_col, std::int64_t last_col)
+{
+    first_row = std::max<std::int64_t>(first_row, 0);
+    last_row = std::min<std::int64_t>(last_row, m_tile_rows);
+    first_col = std::max<std::int64_t>(first_col, 0);
+    last_col = std::min<std::int64_t>(last_col, m_tile_cols);
+    for (std::int64_t row = first_row; row < last_row; ++row)
+    {
+        for (std::int64_t col = first_col; col < last_col; ++col)
+        {
+            std::uint64_t key = WorldGrid::chunk_key(static_cast<std::int32_t>(row), static_cast<std::int32_t>(col));
+            // a tile which is being loaded will be added to m_loaded when it is done
+            if (m_requested.insert(key).second && !m_loaded.count(key) && !m_loading.count(key))
+            {
+                m_requests.push_back(key);
+            }
+        }
+    }
+}
+
+void MapStreamer::wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_requests.empty() && m_loading.empty(); });
+}
+
+std::size_t MapStreamer::loaded_tiles() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_loaded.size();
+}
+
+void MapStreamer::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_work_ready.wait(lock, [this] { return m_is_stopping || !m_requests.empty(); });
+        if (m_is_stopping)
+        {
+            return;
+        }
+
+        std::uint64_t key = m_requests.front();
+        m_requests.pop_front();
+        if (!m_loaded.count(key))
+        {
+            m_loading.insert(key);
+            lock.unlock();
+            load(key);
+            lock.lock();
+            m_loading.erase(key);
+            m_lru.push_front(key);
+            m_loaded[key] = m_lru.begin();
+            evict();
+        }
+
+        if (m_requests.empty())
+        {
+            m_idle.notify_all();
+        }
+    }
+}
+
+void MapStreamer::load(std::uint64_t key)
+{
+    std::uint32_t row = static_cast<std::uint32_t>(key >> 32);
+    std::uint32_t col = static_cast<std::uint32_t>(key);
+    std::uint64_t offset = recording::get<std::uint64_t>(m_index + (static_cast<std::size_t>(row) * m_tile_cols + col) * 8);
+    if (offset == 0 || m_file->size() < TILE_CELLS * tile_map::CELL_SIZE || offset > m_file->size() - TILE_CELLS * tile_map::CELL_SIZE)
+    {
+        // blank tiles are not stored, and a missing chunk is blank
+        return;
+    }
+
+    // reading the tile is what pages it in, so it happens outside of any lock
+    auto chunk = std::make_unique<WorldGrid::Chunk>();
+    const char *data = m_file->data() + offset;
+    for (std::size_t i = 0; i < TILE_CELLS; ++i, data += tile_map::CELL_SIZE)
+    {
+        std::uint16_t handle = recording::get<std::uint16_t>(data + 1);
+        chunk->cells[i] = Cell{data[0], handle < m_handles.size() ? m_handles[handle] : ColorHandle(0)};
+    }
+
+    // a chunk which is already there was drawn by the application, and is kept
+    std::lock_guard<std::mutex> guard(m_world->m_mutex);
+    m_world->m_chunks.emplace(key, std::move(chunk));
+}
+
+void MapStreamer::evict()
+{
+    // tiles under the view are kept, even beyond the limit
+    auto it = m_lru.end();
+    while (m_loaded.size() > m_max_tiles && it != m_lru.begin())
+    {
+        --it;
+        if (m_visible.count(*it))
+        {
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(m_world->m_mutex);
+            auto chunk = m_world->m_chunks.find(*it);
+            if (chunk != m_world->m_chunks.end() && !chunk->second->is_modified)
+            {
+                m_world->m_chunks.erase(chunk);
+            }
+        }
+
+        m_loaded.erase(*it);
+        it = m_lru.erase(it);
+    }
+}
+} // namespace gk
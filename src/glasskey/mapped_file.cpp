@@ -0,0 +1,122 @@
+#include "glasskey/mapped_file.h"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace gk
+{
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string &path) : m_data(nullptr), m_size(0), m_file(INVALID_HANDLE_VALUE), m_mapping(nullptr)
+{
+    m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    LARGE_INTEGER size;
+    if (m_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_file, &size))
+    {
+        release();
+        throw std::runtime_error("Unable to open " + path);
+    }
+
+    m_size = static_cast<std::size_t>(size.QuadPart);
+    if (m_size == 0)
+    {
+        return;
+    }
+
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    m_data = m_mapping ? static_cast<const char *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+    if (m_data == nullptr)
+    {
+        release();
+        throw std::runtime_error("Unable to map " + path);
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    release();
+}
+
+void MappedFile::release()
+{
+    if (m_data)
+    {
+        UnmapViewOfFile(m_data);
+    }
+
+    if (m_mapping)
+    {
+        CloseHandle(m_mapping);
+    }
+
+    if (m_file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(m_file);
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const std::string &path) : m_data(nullptr), m_size(0), m_fd(open(path.c_str(), O_RDONLY))
+{
+    struct stat info;
+    if (m_fd < 0 || fstat(m_fd, &info) != 0)
+    {
+        release();
+        throw std::runtime_error("Unable to open " + path);
+    }
+
+    m_size = static_cast<std::size_t>(info.st_size);
+    if (m_size == 0)
+    {
+        return;
+    }
+
+    void *data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (data == MAP_FAILED)
+    {
+        release();
+        throw std::runtime_error("Unable to map " + path);
+    }
+
+    m_data = static_cast<const char *>(data);
+}
+
+MappedFile::~MappedFile()
+{
+    release();
+}
+
+void MappedFile::release()
+{
+    if (m_data)
+    {
+        munmap(const_cast<char *>(m_data), m_size);
+    }
+
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+    }
+}
+
+#endif
+
+const char *MappedFile::data() const
+{
+    return m_data;
+}
+
+std::size_t MappedFile::size() const
+{
+    return m_size;
+}
+} // namespace gk
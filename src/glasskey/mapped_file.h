@@ -0,0 +1,48 @@
+#ifndef _GK_MAPPED_FILE_H_
+#define _GK_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+
+namespace gk
+{
+/** A read-only view of a file mapped into memory. Pages are read from disk
+ *  by the operating system as they are touched, so only the parts of the
+ *  file which are actually used take up memory.
+ */
+class MappedFile
+{
+public:
+    /** Constructor. Throws std::runtime_error if the file cannot be mapped.
+     *
+     *  \param path the path of the file to map
+     */
+    MappedFile(const std::string &path);
+
+    /** Destructor. */
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /** The contents of the file */
+    const char *data() const;
+
+    /** The size of the file in bytes */
+    std::size_t size() const;
+
+private:
+    void release();
+
+    const char *m_data;
+    std::size_t m_size;
+#ifdef _WIN32
+    void *m_file;
+    void *m_mapping;
+#else
+    int m_fd;
+#endif
+};
+} // namespace gk
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef _GK_RECORDING_H_
+#define _GK_RECORDING_H_
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace gk
+{
+/** Layout of the files written by TextGrid::start_recording(). All values
+ *  are little-endian and records are packed without padding.
+ *
+ *  The file begins with a header:
+ *
+ *      char[4]  magic "GKRC"
+ *      uint16   format version
+ *      uint16   rows
+ *      uint16   cols
+ *      uint16   reserved
+ *      uint32   keyframe interval
+ *
+ *  which is followed by a sequence of records, each starting with a one byte
+ *  type. Every cell is stored as its ASCII value (uint8) followed by its
+ *  palette handle (uint16).
+ *
+ *      PALETTE:  uint32 count, then count packed RGBA8 colors (uint32).
+ *                Replaces the palette used to resolve the cells which follow.
+ *                Written whenever the palette changes, and always directly
+ *                before a keyframe, so that playback can start there.
+ *      KEYFRAME: uint64 time in microseconds, uint32 frame number, then
+ *                rows * cols cells in row-major order.
+ *      DELTA:    uint64 time in microseconds, uint32 frame number, uint32
+ *                run count, then for each run uint16 row, uint16 col,
+ *                uint16 length and length cells. Cells not in a run are
+ *                unchanged from the previous frame.
+ *      INDEX:    uint32 frame count, uint64 time of the last frame, uint32
+ *                keyframe count, then for each keyframe uint32 frame number,
+ *                uint64 time and the uint64 file offset of the palette which
+ *                precedes it. Written once, when recording stops.
+ *
+ *  A complete file ends with a trailer which locates the index:
+ *
+ *      uint64   file offset of the INDEX record
+ *      char[4]  magic "GKIX"
+ *      uint32   reserved
+ *
+ *  Files without a trailer, e.g. because the recording was interrupted, can
+ *  still be played by scanning the records.
+ */
+namespace recording
+{
+const char MAGIC[4] = {'G', 'K', 'R', 'C'};
+const std::uint16_t VERSION = 1;
+const std::size_t HEADER_SIZE = 16;
+const std::size_t CELL_SIZE = 3;
+const std::size_t RUN_HEADER_SIZE = 6;
+const char INDEX_MAGIC[4] = {'G', 'K', 'I', 'X'};
+const std::size_t INDEX_ENTRY_SIZE = 20;
+const std::size_t TRAILER_SIZE = 16;
+
+const std::uint8_t PALETTE = 'P';
+const std::uint8_t KEYFRAME = 'K';
+const std::uint8_t DELTA = 'D';
+const std::uint8_t INDEX = 'I';
+
+/** Appends a little-endian value to a buffer */
+template <typename T>
+void put(std::vector<char> &buffer, T value)
+{
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+    {
+        buffer.push_back(static_cast<char>((static_cast<std::uint64_t>(value) >> (8 * i)) & 0xFF));
+    }
+}
+
+/** Reads a little-endian value from a buffer */
+template <typename T>
+T get(const char *data)
+{
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+    {
+        value |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(data[i])) << (8 * i);
+    }
+
+    return static_cast<T>(value);
+}
+} // namespace recording
+} // namespace gk
+
+#endif
@@ -0,0 +1,86 @@
+#include "glasskey/render_stats.h"
+
+namespace
+{
+double to_seconds(std::uint64_t nanoseconds)
+{
+    return nanoseconds * 1e-9;
+}
+} // namespace
+
+namespace gk
+{
+void PhaseCounter::add(std::chrono::steady_clock::duration duration)
+{
+    std::uint64_t nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_total.fetch_add(nanoseconds, std::memory_order_relaxed);
+    m_last.store(nanoseconds, std::memory_order_relaxed);
+    std::uint64_t max = m_max.load(std::memory_order_relaxed);
+    while (nanoseconds > max && !m_max.compare_exchange_weak(max, nanoseconds, std::memory_order_relaxed))
+    {
+    }
+}
+
+PhaseStats PhaseCounter::stats() const
+{
+    return {m_count.load(std::memory_order_relaxed),
+            to_seconds(m_total.load(std::memory_order_relaxed)),
+            to_seconds(m_max.load(std::memory_order_relaxed)),
+            to_seconds(m_last.load(std::memory_order_relaxed))};
+}
+
+void PhaseCounter::reset()
+{
+    m_count.store(0, std::memory_order_relaxed);
+    m_total.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+    m_last.store(0, std::memory_order_relaxed);
+}
+
+RenderStats render_stats()
+{
+    StatsCounters &counters = stats_counters();
+    RenderStats stats;
+    stats.frames_blitted = counters.frames_blitted.load(std::memory_order_relaxed);
+    stats.frames_presented = counters.frames_presented.load(std::memory_order_relaxed);
+    stats.frames_dropped = counters.frames_dropped.load(std::memory_order_relaxed);
+    stats.frames_not_recorded = counters.frames_not_recorded.load(std::memory_order_relaxed);
+    stats.cells_drawn = counters.cells_drawn.load(std::memory_order_relaxed);
+    stats.lock_wait = counters.lock_wait.stats();
+    stats.blit = counters.blit.stats();
+    stats.draw_rows = counters.draw_rows.stats();
+    stats.present = counters.present.stats();
+    stats.update = counters.update.stats();
+    stats.idle = counters.idle.stats();
+    stats.oversleep = counters.oversleep.stats();
+    return stats;
+}
+
+void reset_render_stats()
+{
+    StatsCounters &counters = stats_counters();
+    counters.frames_blitted.store(0, std::memory_order_relaxed);
+    counters.frames_presented.store(0, std::memory_order_relaxed);
+    counters.frames_dropped.store(0, std::memory_order_relaxed);
+    counters.frames_not_recorded.store(0, std::memory_order_relaxed);
+    counters.cells_drawn.store(0, std::memory_order_relaxed);
+    counters.lock_wait.reset();
+    counters.blit.reset();
+    counters.draw_rows.reset();
+    counters.present.reset();
+    counters.update.reset();
+    counters.idle.reset();
+    counters.oversleep.reset();
+}
+
+void set_timing_enabled(bool enabled)
+{
+    stats_counters().is_timing.store(enabled, std::memory_order_relaxed);
+}
+
+bool is_timing_enabled()
+{
+    return stats_counters().is_timing.load(std::memory_order_relaxed);
+}
+} // namespace gk
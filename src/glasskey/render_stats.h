@@ -0,0 +1,96 @@
+#ifndef _GK_RENDER_STATS_H_
+#define _GK_RENDER_STATS_H_
+
+#include "glasskey/glasskey.h"
+
+namespace gk
+{
+/** Accumulates the durations of one phase. Can be updated from any thread. */
+class PhaseCounter
+{
+public:
+    /** Adds the duration of one occurrence of the phase */
+    void add(std::chrono::steady_clock::duration duration);
+
+    /** The durations added since the last reset, in seconds */
+    PhaseStats stats() const;
+
+    /** Clears the durations */
+    void reset();
+
+private:
+    std::atomic<std::uint64_t> m_count{0};
+    std::atomic<std::uint64_t> m_total{0};
+    std::atomic<std::uint64_t> m_max{0};
+    std::atomic<std::uint64_t> m_last{0};
+};
+
+/** The counters returned by render_stats(). Plain counts are always kept with
+ *  relaxed atomic adds; phases are only timed while timing is enabled, as
+ *  reading the clock costs more than the operations being counted.
+ */
+struct StatsCounters
+{
+    std::atomic<bool> is_timing{false};
+    std::atomic<std::uint64_t> frames_blitted{0};
+    std::atomic<std::uint64_t> frames_presented{0};
+    std::atomic<std::uint64_t> frames_dropped{0};
+    std::atomic<std::uint64_t> frames_not_recorded{0};
+    std::atomic<std::uint64_t> cells_drawn{0};
+    PhaseCounter lock_wait;
+    PhaseCounter blit;
+    PhaseCounter draw_rows;
+    PhaseCounter present;
+    PhaseCounter update;
+    PhaseCounter idle;
+    PhaseCounter oversleep;
+};
+
+/** The counters shared by all grids and the render thread */
+inline StatsCounters &stats_counters()
+{
+    static StatsCounters counters;
+    return counters;
+}
+
+/** Adds to a count */
+inline void add_count(std::atomic<std::uint64_t> &counter, std::uint64_t value = 1)
+{
+    counter.fetch_add(value, std::memory_order_relaxed);
+}
+
+/** Times a phase from construction to destruction, if timing is enabled */
+class PhaseTimer
+{
+public:
+    /** Constructor.
+     *
+     *  \param counter receives the duration of the phase
+     */
+    PhaseTimer(PhaseCounter &counter) : m_counter(stats_counters().is_timing.load(std::memory_order_relaxed) ? &counter : nullptr)
+    {
+        if (m_counter)
+        {
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+
+    /** Destructor. Adds the duration of the phase. */
+    ~PhaseTimer()
+    {
+        if (m_counter)
+        {
+            m_counter->add(std::chrono::steady_clock::now() - m_start);
+        }
+    }
+
+    PhaseTimer(const PhaseTimer &) = delete;
+    PhaseTimer &operator=(const PhaseTimer &) = delete;
+
+private:
+    PhaseCounter *m_counter;
+    std::chrono::steady_clock::time_point m_start;
+};
+} // namespace gk
+
+#endif
@@ -0,0 +1,444 @@
+#include "glasskey/glasskey.h"
+#include "glasskey/mapped_file.h"
+#include "glasskey/recording.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+const double MICROSECONDS = 1e6;
+const std::size_t FRAME_HEADER_SIZE = 1 + 8 + 4;
+} // namespace
+
+namespace gk
+{
+ReplayPlayer::ReplayPlayer(const std::string &path) : m_file(std::make_unique<MappedFile>(path)),
+                                                      m_frames(0),
+                                                      m_duration(0),
+                                                      m_offset(recording::HEADER_SIZE),
+                                                      m_frame(0),
+                                                      m_frame_time(0),
+                                                      m_time(0),
+                                                      m_palette{Colors::White},
+                                                      m_palette_changed(true),
+                                                      m_last_grid(0),
+                                                      m_grid_palette_version(0)
+{
+    const char *data = m_file->data();
+    if (m_file->size() < recording::HEADER_SIZE ||
+        !std::equal(recording::MAGIC, recording::MAGIC + sizeof(recording::MAGIC), data) ||
+        recording::get<std::uint16_t>(data + 4) != recording::VERSION)
+    {
+        throw std::runtime_error(path + " is not a glasskey recording");
+    }
+
+    m_rows = recording::get<std::uint16_t>(data + 6);
+    m_cols = recording::get<std::uint16_t>(data + 8);
+    m_cells.assign(static_cast<std::size_t>(m_rows) * m_cols, Cell{' ', 0});
+    m_changed.assign(m_rows, true);
+
+    if (!read_index())
+    {
+        scan_index();
+    }
+
+    // every frame is decoded forward from the last keyframe at or before it
+    auto by_frame = [](const Keyframe &lhs, const Keyframe &rhs) { return lhs.frame < rhs.frame; };
+    if (m_frames > 0 && (m_keyframes.empty() || m_keyframes.front().frame != 0 ||
+                         !std::is_sorted(m_keyframes.begin(), m_keyframes.end(), by_frame)))
+    {
+        throw std::runtime_error(path + " has a corrupt keyframe index");
+    }
+
+    if (!m_keyframes.empty())
+    {
+        seek_keyframe(0);
+    }
+}
+
+ReplayPlayer::~ReplayPlayer()
+{
+}
+
+bool ReplayPlayer::read_index()
+{
+    const char *data = m_file->data();
+    std::size_t size = m_file->size();
+    if (size < recording::HEADER_SIZE + recording::TRAILER_SIZE)
+    {
+        return false;
+    }
+
+    const char *trailer = data + size - recording::TRAILER_SIZE;
+    if (!std::equal(recording::INDEX_MAGIC, recording::INDEX_MAGIC + sizeof(recording::INDEX_MAGIC), trailer + 8))
+    {
+        return false;
+    }
+
+    std::uint64_t offset = recording::get<std::uint64_t>(trailer);
+    std::size_t end = size - recording::TRAILER_SIZE;
+    if (offset < recording::HEADER_SIZE || offset + 17 > end || static_cast<std::uint8_t>(data[offset]) != recording::INDEX)
+    {
+        return false;
+    }
+
+    const char *index = data + offset + 1;
+    std::uint32_t count = recording::get<std::uint32_t>(index + 12);
+    if (offset + 17 + static_cast<std::uint64_t>(count) * recording::INDEX_ENTRY_SIZE > end)
+    {
+        return false;
+    }
+
+    m_frames = recording::get<std::uint32_t>(index);
+    m_duration = recording::get<std::uint64_t>(index + 4);
+    m_keyframes.resize(count);
+    const char *entry = index + 16;
+    for (auto &keyframe : m_keyframes)
+    {
+        keyframe.frame = recording::get<std::uint32_t>(entry);
+        keyframe.time = recording::get<std::uint64_t>(entry + 4);
+        keyframe.offset = recording::get<std::uint64_t>(entry + 12);
+        entry += recording::INDEX_ENTRY_SIZE;
+    }
+
+    return true;
+}
+
+void ReplayPlayer::scan_index()
+{
+    // the recording was not closed properly, so every complete record is
+    // visited once to find the keyframes
+    const char *data = m_file->data();
+    std::size_t size = m_file->size();
+    std::size_t offset = recording::HEADER_SIZE;
+    std::size_t palette_offset = 0;
+    std::size_t num_cells = m_cells.size();
+    while (offset < size)
+    {
+        std::uint8_t type = static_cast<std::uint8_t>(data[offset]);
+        std::size_t next = 0;
+        if (type == recording::PALETTE && offset + 5 <= size)
+        {
+            next = offset + 5 + static_cast<std::size_t>(recording::get<std::uint32_t>(data + offset + 1)) * 4;
+        }
+        else if (type == recording::KEYFRAME && offset + FRAME_HEADER_SIZE <= size)
+        {
+            next = offset + FRAME_HEADER_SIZE + num_cells * recording::CELL_SIZE;
+        }
+        else if (type == recording::DELTA && offset + FRAME_HEADER_SIZE + 4 <= size)
+        {
+            std::uint32_t runs = recording::get<std::uint32_t>(data + offset + FRAME_HEADER_SIZE);
+            next = offset + FRAME_HEADER_SIZE + 4;
+            for (std::uint32_t run = 0; run < runs && next + recording::RUN_HEADER_SIZE <= size; ++run)
+            {
+                next += recording::RUN_HEADER_SIZE + recording::get<std::uint16_t>(data + next + 4) * recording::CELL_SIZE;
+            }
+        }
+
+        if (next == 0 || next > size)
+        {
+            break;
+        }
+
+        if (type == recording::PALETTE)
+        {
+            palette_offset = offset;
+        }
+        else
+        {
+            std::uint64_t time = recording::get<std::uint64_t>(data + offset + 1);
+            if (type == recording::KEYFRAME)
+            {
+                std::uint32_t frame = recording::get<std::uint32_t>(data + offset + 9);
+                m_keyframes.push_back({frame, time, palette_offset ? palette_offset : offset});
+            }
+
+            palette_offset = 0;
+            m_duration = time;
+            ++m_frames;
+        }
+
+        offset = next;
+    }
+}
+
+bool ReplayPlayer::peek_time(std::uint64_t &time) const
+{
+    const char *data = m_file->data();
+    std::size_t size = m_file->size();
+    std::size_t offset = m_offset;
+    while (offset + 5 <= size && static_cast<std::uint8_t>(data[offset]) == recording::PALETTE)
+    {
+        offset += 5 + static_cast<std::size_t>(recording::get<std::uint32_t>(data + offset + 1)) * 4;
+    }
+
+    if (offset + FRAME_HEADER_SIZE > size)
+    {
+        return false;
+    }
+
+    std::uint8_t type = static_cast<std::uint8_t>(data[offset]);
+    if (type != recording::KEYFRAME && type != recording::DELTA)
+    {
+        return false;
+    }
+
+    time = recording::get<std::uint64_t>(data + offset + 1);
+    return true;
+}
+
+std::size_t ReplayPlayer::read_cells(std::size_t offset, Cell *cells, std::size_t count)
+{
+    const char *data = m_file->data() + offset;
+    for (std::size_t i = 0; i < count; ++i, data += recording::CELL_SIZE)
+    {
+        cells[i] = Cell{data[0], recording::get<std::uint16_t>(data + 1)};
+    }
+
+    return offset + count * recording::CELL_SIZE;
+}
+
+bool ReplayPlayer::read_frame()
+{
+    const char *data = m_file->data();
+    std::size_t size = m_file->size();
+    std::size_t offset = m_offset;
+    while (offset + 5 <= size && static_cast<std::uint8_t>(data[offset]) == recording::PALETTE)
+    {
+        std::uint32_t count = recording::get<std::uint32_t>(data + offset + 1);
+        if (offset + 5 + static_cast<std::size_t>(count) * 4 > size)
+        {
+            return false;
+        }
+
+        m_palette.resize(count);
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            m_palette[i] = Color::from_rgba(recording::get<std::uint32_t>(data + offset + 5 + i * 4));
+        }
+
+        m_palette_changed = true;
+        offset += 5 + static_cast<std::size_t>(count) * 4;
+        m_offset = offset;
+    }
+
+    if (offset + FRAME_HEADER_SIZE > size)
+    {
+        return false;
+    }
+
+    std::uint8_t type = static_cast<std::uint8_t>(data[offset]);
+    std::uint64_t time = recording::get<std::uint64_t>(data + offset + 1);
+    std::uint32_t frame = recording::get<std::uint32_t>(data + offset + 9);
+    offset += FRAME_HEADER_SIZE;
+    if (type == recording::KEYFRAME)
+    {
+        if (offset + m_cells.size() * recording::CELL_SIZE > size)
+        {
+            return false;
+        }
+
+        offset = read_cells(offset, m_cells.data(), m_cells.size());
+        std::fill(m_changed.begin(), m_changed.end(), true);
+    }
+    else if (type == recording::DELTA && offset + 4 <= size)
+    {
+        std::uint32_t runs = recording::get<std::uint32_t>(data + offset);
+        offset += 4;
+        for (std::uint32_t run = 0; run < runs; ++run)
+        {
+            if (offset + recording::RUN_HEADER_SIZE > size)
+            {
+                return false;
+            }
+
+            Size row = recording::get<std::uint16_t>(data + offset);
+            Size col = recording::get<std::uint16_t>(data + offset + 2);
+            Size length = recording::get<std::uint16_t>(data + offset + 4);
+            offset += recording::RUN_HEADER_SIZE;
+            if (row >= m_rows || col + length > m_cols)
+            {
+                throw std::runtime_error("Corrupt run in recording");
+            }
+
+            if (offset + length * recording::CELL_SIZE > size)
+            {
+                return false;
+            }
+
+            offset = read_cells(offset, m_cells.data() + static_cast<std::size_t>(row) * m_cols + col, length);
+            m_changed[row] = true;
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    m_offset = offset;
+    m_frame = frame;
+    m_frame_time = time;
+    return true;
+}
+
+Size ReplayPlayer::rows() const
+{
+    return m_rows;
+}
+
+Size ReplayPlayer::cols() const
+{
+    return m_cols;
+}
+
+std::uint32_t ReplayPlayer::frames() const
+{
+    return m_frames;
+}
+
+std::uint32_t ReplayPlayer::keyframes() const
+{
+    return static_cast<std::uint32_t>(m_keyframes.size());
+}
+
+std::uint32_t ReplayPlayer::frame() const
+{
+    return m_frame;
+}
+
+double ReplayPlayer::time() const
+{
+    return m_keyframes.empty() ? 0 : (m_time - m_keyframes.front().time) / MICROSECONDS;
+}
+
+double ReplayPlayer::duration() const
+{
+    return m_keyframes.empty() ? 0 : (m_duration - m_keyframes.front().time) / MICROSECONDS;
+}
+
+bool ReplayPlayer::is_finished() const
+{
+    std::uint64_t time;
+    return !peek_time(time);
+}
+
+void ReplayPlayer::seek_keyframe(std::uint32_t keyframe)
+{
+    if (keyframe >= m_keyframes.size())
+    {
+        throw std::out_of_range("Keyframe " + std::to_string(keyframe) + " is not in the recording");
+    }
+
+    m_offset = static_cast<std::size_t>(m_keyframes[keyframe].offset);
+    if (!read_frame())
+    {
+        throw std::runtime_error("Keyframe " + std::to_string(keyframe) + " is truncated");
+    }
+
+    m_time = static_cast<double>(m_frame_time);
+}
+
+void ReplayPlayer::seek(std::uint32_t frame)
+{
+    if (frame >= m_frames)
+    {
+        throw std::out_of_range("Frame " + std::to_string(frame) + " is not in the recording");
+    }
+
+    auto keyframe = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), frame,
+                                     [](std::uint32_t value, const Keyframe &keyframe) { return value < keyframe.frame; });
+    std::uint32_t index = static_cast<std::uint32_t>(keyframe - m_keyframes.begin()) - 1;
+
+    // decoding forward is cheaper than going back to the keyframe as long
+    // as the target is in the same stretch between keyframes
+    if (frame < m_frame || m_keyframes[index].frame > m_frame)
+    {
+        seek_keyframe(index);
+    }
+
+    while (m_frame < frame && read_frame())
+    {
+    }
+
+    m_time = static_cast<double>(m_frame_time);
+}
+
+bool ReplayPlayer::step()
+{
+    if (!read_frame())
+    {
+        return false;
+    }
+
+    m_time = static_cast<double>(m_frame_time);
+    return true;
+}
+
+std::uint32_t ReplayPlayer::advance(double seconds)
+{
+    m_time += seconds * MICROSECONDS;
+    std::uint32_t count = 0;
+    std::uint64_t time;
+    while (peek_time(time) && time <= m_time && read_frame())
+    {
+        ++count;
+    }
+
+    return count;
+}
+
+void ReplayPlayer::show(TextGrid &text_grid)
+{
+    auto guard = text_grid.lock_rows();
+    bool is_new = text_grid.m_serial != m_last_grid;
+    if (is_new || m_palette_changed || text_grid.m_palette_version != m_grid_palette_version)
+    {
+        text_grid.intern_colors(m_palette, m_handles);
+
+        // the handles of the grid may have been remapped, so every row is redrawn
+        m_grid_palette_version = text_grid.m_palette_version;
+        std::fill(m_changed.begin(), m_changed.end(), true);
+    }
+
+    Size rows = std::min(m_rows, text_grid.rows());
+    Size cols = std::min(m_cols, text_grid.cols());
+    for (Size row = 0; row < rows; ++row)
+    {
+        if (!m_changed[row])
+        {
+            continue;
+        }
+
+        const Cell *cells = m_cells.data() + static_cast<std::size_t>(row) * m_cols;
+        Cell *target = text_grid.row_cells(row);
+        for (Size col = 0; col < cols; ++col)
+        {
+            ColorHandle color = cells[col].color < m_handles.size() ? m_handles[cells[col].color] : text_grid.m_default_handle;
+            target[col] = Cell{cells[col].value, color};
+        }
+
+        text_grid.damage(row, row + 1);
+    }
+
+    std::fill(m_changed.begin(), m_changed.end(), false);
+    m_palette_changed = false;
+    m_last_grid = text_grid.m_serial;
+}
+
+void ReplayPlayer::play(const std::shared_ptr<TextGrid> &text_grid, float frames_per_second, float speed)
+{
+    while (true)
+    {
+        show(*text_grid);
+        text_grid->blit();
+        if (is_finished())
+        {
+            break;
+        }
+
+        next_frame(frames_per_second);
+        advance(speed / frames_per_second);
+    }
+}
+} // namespace gk
@@ -0,0 +1,82 @@
+#include "glasskey/glasskey.h"
+
+#include <algorithm>
+
+namespace gk
+{
+Sprite::Sprite(const std::vector<std::string> &lines, char transparent) : m_rows(static_cast<Size>(lines.size())),
+                                                                           m_cols(0)
+{
+    std::vector<Cell> cells;
+    for (Size row = 0; row < m_rows; ++row)
+    {
+        const std::string &line = lines[row];
+        cells.clear();
+        std::transform(line.begin(), line.end(), std::back_inserter(cells),
+                       [](char value) -> Cell { return Cell{value, MAPPED}; });
+        add_row(row, cells.data(), static_cast<Size>(cells.size()), transparent);
+    }
+}
+
+Sprite::Sprite(const std::vector<std::vector<Letter>> &letters, char transparent) : m_rows(static_cast<Size>(letters.size())),
+                                                                                     m_cols(0)
+{
+    std::vector<Cell> cells;
+    for (Size row = 0; row < m_rows; ++row)
+    {
+        cells.clear();
+        for (const Letter &letter : letters[row])
+        {
+            auto it = std::find(m_palette.begin(), m_palette.end(), letter.color());
+            if (it == m_palette.end())
+            {
+                it = m_palette.insert(m_palette.end(), letter.color());
+            }
+
+            cells.push_back(Cell{letter.value(), static_cast<ColorHandle>(it - m_palette.begin())});
+        }
+
+        add_row(row, cells.data(), static_cast<Size>(cells.size()), transparent);
+    }
+}
+
+void Sprite::add_row(Size row, const Cell *cells, Size count, char transparent)
+{
+    m_cols = std::max(m_cols, count);
+    Size col = 0;
+    while (col < count)
+    {
+        if (cells[col].value == transparent)
+        {
+            ++col;
+            continue;
+        }
+
+        Size first = col;
+        while (col < count && cells[col].value != transparent)
+        {
+            ++col;
+        }
+
+        m_runs.push_back({row, first, static_cast<Size>(col - first), m_cells.size()});
+        m_cells.insert(m_cells.end(), cells + first, cells + col);
+    }
+}
+
+Size Sprite::rows() const
+{
+    return m_rows;
+}
+
+Size Sprite::cols() const
+{
+    return m_cols;
+}
+
+bool Sprite::is_opaque(Size row, Size col) const
+{
+    return std::any_of(m_runs.begin(), m_runs.end(), [row, col](const Run &run) {
+        return run.row == row && col >= run.col && col < run.col + run.length;
+    });
+}
+} // namespace gk
@@ -0,0 +1,126 @@
+#include "glasskey/backend.h"
+#include "glasskey/render_stats.h"
+#include "glasskey/terminal_renderer.h"
+#include "glasskey/wakeup.h"
+
+#include <cstdio>
+#include <map>
+
+namespace
+{
+const char ENTER_TERMINAL[] = "\x1b[?1049h\x1b[?25l\x1b[0m\x1b[2J";
+const char LEAVE_TERMINAL[] = "\x1b[0m\x1b[?25h\x1b[?1049l";
+} // namespace
+
+namespace gk
+{
+/** Backend which draws grids as text on the terminal attached to standard
+ *  output, e.g. over SSH. Grids are stacked from the top of the screen in the
+ *  order they are created. Only the cells which have changed since the last
+ *  frame are sent, and all of the grids updated at once are written with a
+ *  single call. Keyboard input is not gathered.
+ */
+class TerminalBackend : public Backend
+{
+public:
+    TerminalBackend() : m_next_id(1), m_next_top(0), m_is_active(false), m_cursor{-1, 0, 0}
+    {
+    }
+
+    ~TerminalBackend()
+    {
+        leave();
+    }
+
+    void init(const std::vector<std::string> & /*args*/) override
+    {
+    }
+
+    void open(const std::shared_ptr<TextGrid> &text_grid) override
+    {
+        text_grid->id() = m_next_id++;
+        m_grids[text_grid->id()] = text_grid;
+        m_renderers[text_grid->id()] = std::make_unique<TerminalRenderer>(text_grid->rows(), text_grid->cols(), m_next_top, m_cursor, m_output);
+        m_next_top += text_grid->rows();
+    }
+
+    void close(const std::shared_ptr<TextGrid> &text_grid) override
+    {
+        m_grids.erase(text_grid->id());
+        m_renderers.erase(text_grid->id());
+        if (m_grids.empty())
+        {
+            leave();
+            m_next_top = 0;
+        }
+    }
+
+    void update() override
+    {
+        for (auto &pair : m_grids)
+        {
+            if (pair.second->is_dirty())
+            {
+                enter();
+                pair.second->draw_rows(*m_renderers[pair.first]);
+            }
+        }
+
+        flush();
+    }
+
+    void wait() override
+    {
+        render_thread_wakeup().wait(false);
+    }
+
+private:
+    void enter()
+    {
+        if (!m_is_active)
+        {
+            m_output.append(ENTER_TERMINAL);
+            m_cursor = {-1, 0, 0};
+            m_is_active = true;
+        }
+    }
+
+    void leave()
+    {
+        if (m_is_active)
+        {
+            m_output.append(LEAVE_TERMINAL);
+            flush();
+            m_is_active = false;
+            for (auto &pair : m_renderers)
+            {
+                pair.second->invalidate();
+            }
+        }
+    }
+
+    void flush()
+    {
+        if (!m_output.empty())
+        {
+            PhaseTimer timer(stats_counters().present);
+            std::fwrite(m_output.data(), 1, m_output.size(), stdout);
+            std::fflush(stdout);
+            m_output.clear();
+        }
+    }
+
+    int m_next_id;
+    int m_next_top;
+    bool m_is_active;
+    TerminalCursor m_cursor;
+    std::string m_output;
+    std::map<int, std::shared_ptr<TextGrid>> m_grids;
+    std::map<int, std::unique_ptr<TerminalRenderer>> m_renderers;
+};
+
+std::unique_ptr<Backend> create_terminal_backend()
+{
+    return std::make_unique<TerminalBackend>();
+}
+} // namespace gk
@@ -0,0 +1,222 @@
+#include "glasskey/terminal_renderer.h"
+
+#include <algorithm>
+
+namespace
+{
+const std::uint32_t OPAQUE = 0xFF000000u;
+
+std::size_t num_digits(int value)
+{
+    std::size_t digits = 1;
+    for (; value >= 10; value /= 10)
+    {
+        ++digits;
+    }
+
+    return digits;
+}
+
+void append_number(std::string &output, int value)
+{
+    char digits[12];
+    int count = 0;
+    do
+    {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value);
+
+    while (count)
+    {
+        output.push_back(digits[--count]);
+    }
+}
+} // namespace
+
+namespace gk
+{
+TerminalRenderer::TerminalRenderer(Size rows, Size cols, int top, TerminalCursor &cursor, std::string &output) : m_rows(rows),
+                                                                                                               m_cols(cols),
+                                                                                                               m_top(top),
+                                                                                                               m_cursor(cursor),
+                                                                                                               m_output(output),
+                                                                                                               m_is_valid(false),
+                                                                                                               m_version(0),
+                                                                                                               m_shown(static_cast<std::size_t>(rows) * cols, Shown{' ', 0}),
+                                                                                                               m_row(cols)
+{
+}
+
+void TerminalRenderer::invalidate()
+{
+    std::fill(m_shown.begin(), m_shown.end(), Shown{' ', 0});
+    m_is_valid = false;
+}
+
+TerminalRenderer::Shown TerminalRenderer::to_shown(const Cell &cell, const std::vector<Color> &palette) const
+{
+    // a space looks the same in any color, so it never needs the color changed
+    if (cell.value == ' ')
+    {
+        return Shown{' ', 0};
+    }
+
+    char value = cell.value > ' ' && cell.value < 127 ? cell.value : '?';
+    return Shown{value, palette[cell.color].rgba() | OPAQUE};
+}
+
+void TerminalRenderer::render(const FrameView &frame)
+{
+    // if some of the scrolls are unknown every row is compared instead
+    bool is_shifted = !m_is_valid || frame.shift_floor <= m_version;
+    for (std::size_t i = 0; is_shifted && m_is_valid && i < frame.shift_count; ++i)
+    {
+        if (frame.shifts[i].version > m_version)
+        {
+            scroll(frame.shifts[i]);
+        }
+    }
+
+    const std::vector<Color> &palette = *frame.palette;
+    for (Size row = 0; row < m_rows; ++row)
+    {
+        if (m_is_valid && is_shifted && frame.row_versions[row] <= m_version)
+        {
+            continue;
+        }
+
+        const Cell *cells = frame.cells + static_cast<std::size_t>(row) * m_cols;
+        for (Size col = 0; col < m_cols; ++col)
+        {
+            m_row[col] = to_shown(cells[col], palette);
+        }
+
+        Shown *shown = m_shown.data() + static_cast<std::size_t>(row) * m_cols;
+        for (Size col = 0; col < m_cols; ++col)
+        {
+            if (m_row[col] == shown[col])
+            {
+                continue;
+            }
+
+            move_to(m_row.data(), row, col);
+            put(m_row[col]);
+            shown[col] = m_row[col];
+        }
+    }
+
+    m_version = frame.version;
+    m_is_valid = true;
+}
+
+void TerminalRenderer::scroll(const RowShift &shift)
+{
+    Index height = shift.bottom - shift.top;
+    if (shift.rows == 0 || std::abs(shift.rows) >= height)
+    {
+        return;
+    }
+
+    // the terminal scrolls the rows within a scrolling region itself, and the
+    // rows it exposes are left blank
+    m_output.append("\x1b[");
+    append_number(m_output, m_top + shift.top + 1);
+    m_output.push_back(';');
+    append_number(m_output, m_top + shift.bottom);
+    m_output.append("r\x1b[");
+    append_number(m_output, std::abs(shift.rows));
+    m_output.push_back(shift.rows < 0 ? 'S' : 'T');
+    m_output.append("\x1b[r");
+    m_cursor.row = -1;
+
+    shift_rows(m_shown.data(), m_cols, shift);
+    Index exposed = shift.rows < 0 ? shift.bottom + shift.rows : shift.top;
+    auto first = m_shown.begin() + static_cast<std::size_t>(exposed) * m_cols;
+    std::fill(first, first + static_cast<std::size_t>(std::abs(shift.rows)) * m_cols, Shown{' ', 0});
+}
+
+void TerminalRenderer::move_to(const Shown *cells, int row, int col)
+{
+    int terminal_row = m_top + row;
+    if (m_cursor.row == terminal_row && m_cursor.col == col)
+    {
+        return;
+    }
+
+    std::size_t jump = 4 + num_digits(terminal_row + 1) + num_digits(col + 1);
+    if (m_cursor.row == terminal_row && m_cursor.col < col)
+    {
+        int gap = col - m_cursor.col;
+        std::size_t forward = gap == 1 ? 3 : 3 + num_digits(gap);
+
+        // the cells in the gap are already on screen, so rewriting them is
+        // cheaper than skipping them as long as no color change is needed
+        bool can_rewrite = static_cast<std::size_t>(gap) <= std::min(forward, jump);
+        for (int i = m_cursor.col; can_rewrite && i < col; ++i)
+        {
+            can_rewrite = cells[i].color == 0 || cells[i].color == m_cursor.color;
+        }
+
+        if (can_rewrite)
+        {
+            for (int i = m_cursor.col; i < col; ++i)
+            {
+                m_output.push_back(cells[i].value);
+            }
+
+            m_cursor.col = col;
+            return;
+        }
+
+        if (forward < jump)
+        {
+            m_output.append("\x1b[");
+            if (gap > 1)
+            {
+                append_number(m_output, gap);
+            }
+
+            m_output.push_back('C');
+            m_cursor.col = col;
+            return;
+        }
+    }
+
+    m_output.append("\x1b[");
+    append_number(m_output, terminal_row + 1);
+    if (col > 0)
+    {
+        m_output.push_back(';');
+        append_number(m_output, col + 1);
+    }
+
+    m_output.push_back('H');
+    m_cursor.row = terminal_row;
+    m_cursor.col = col;
+}
+
+void TerminalRenderer::put(const Shown &cell)
+{
+    if (cell.color && cell.color != m_cursor.color)
+    {
+        m_output.append("\x1b[38;2;");
+        append_number(m_output, cell.color & 0xFF);
+        m_output.push_back(';');
+        append_number(m_output, (cell.color >> 8) & 0xFF);
+        m_output.push_back(';');
+        append_number(m_output, (cell.color >> 16) & 0xFF);
+        m_output.push_back('m');
+        m_cursor.color = cell.color;
+    }
+
+    m_output.push_back(cell.value);
+
+    // the terminal may be exactly as wide as the grid, in which case the
+    // cursor is now waiting to wrap and its position cannot be relied on
+    if (++m_cursor.col >= m_cols)
+    {
+        m_cursor.row = -1;
+    }
+}
+} // namespace gk
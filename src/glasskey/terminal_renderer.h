@@ -0,0 +1,87 @@
+#ifndef _GK_TERMINAL_RENDERER_H_
+#define _GK_TERMINAL_RENDERER_H_
+
+#include "glasskey/frame_renderer.h"
+
+#include <string>
+
+namespace gk
+{
+/** The state of a terminal as last left by the escape sequences written to it.
+ *  Shared by all of the renderers which draw to the same terminal.
+ */
+struct TerminalCursor
+{
+    /** The row of the cursor, or -1 if it is unknown */
+    int row;
+
+    /** The column of the cursor */
+    int col;
+
+    /** The current foreground color, or 0 if it is unknown */
+    std::uint32_t color;
+};
+
+/** Draws the frames of a TextGrid to a terminal as ANSI escape sequences with
+ *  truecolor foregrounds. Each frame is diffed against the cells last written,
+ *  and only the changed cells are sent: the cursor is moved with whichever of
+ *  the available sequences is shortest, short gaps between changed runs are
+ *  written over rather than skipped, and colors are only set when they differ
+ *  from the one already in effect. Rows scrolled by TextGrid::scroll() are
+ *  moved with the scrolling region of the terminal rather than resent.
+ */
+class TerminalRenderer : public FrameRenderer
+{
+public:
+    /** Constructor.
+     *
+     *  \param rows the number of rows in the grid
+     *  \param cols the number of columns in the grid
+     *  \param top the terminal row at which the grid is drawn
+     *  \param cursor the state of the terminal being drawn to
+     *  \param output receives the escape sequences
+     */
+    TerminalRenderer(Size rows, Size cols, int top, TerminalCursor &cursor, std::string &output);
+
+    /** Appends the sequences which update the terminal to show the frame.
+     *
+     *  \param frame the frame to draw
+     */
+    void render(const FrameView &frame) override;
+
+    /** Tells the renderer that the terminal has been cleared, so that the next
+     *  call to render() redraws every cell which is not blank. The terminal
+     *  is assumed to be blank when the renderer is constructed.
+     */
+    void invalidate();
+
+private:
+    struct Shown
+    {
+        char value;
+        std::uint32_t color;
+
+        bool operator==(const Shown &other) const
+        {
+            return value == other.value && color == other.color;
+        }
+    };
+
+    Shown to_shown(const Cell &cell, const std::vector<Color> &palette) const;
+    void scroll(const RowShift &shift);
+    void move_to(const Shown *shown, int row, int col);
+    void put(const Shown &cell);
+
+    const Size m_rows;
+    const Size m_cols;
+    const int m_top;
+    TerminalCursor &m_cursor;
+    std::string &m_output;
+    bool m_is_valid;
+    std::uint64_t m_version;
+    std::vector<Shown> m_shown;
+    std::vector<Shown> m_row;
+};
+} // namespace gk
+
+#endif
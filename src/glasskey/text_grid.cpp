@@ -1,15 +1,23 @@
 #include "glasskey/glasskey.h"
-
-#include <GL/freeglut_std.h>
-#include <GL/freeglut_ext.h>
+#include "glasskey/frame_recorder.h"
+#include "glasskey/frame_renderer.h"
+#include "glasskey/render_stats.h"
+#include "glasskey/wakeup.h"
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
 #include <sstream>
+#include <stdexcept>
 
 namespace
 {
-const int COLW = 9;
-const int ROWH = 15;
+// the number of row shifts kept for renderers which have fallen behind
+const std::size_t MAX_SHIFTS = 32;
+
+// identifies each grid for as long as the process runs, unlike its address
+std::atomic<std::uint64_t> g_next_serial{1};
 } // namespace
 
 namespace gk
@@ -39,30 +47,175 @@ std::string Letter::to_string() const
     return stream.str();
 }
 
-Row::Row(Size cols, const Color &color) : std::vector<Letter>(cols)
+Row::Row(const Cell *cells, Size cols, const std::vector<Color> &palette) : m_cells(cells),
+                                                                             m_cols(cols),
+                                                                             m_palette(&palette)
+{
+}
+
+Size Row::size() const
+{
+    return m_cols;
+}
+
+Letter Row::operator[](Size col) const
+{
+    const Cell &cell = m_cells[col];
+    return Letter(cell.value, (*m_palette)[cell.color]);
+}
+
+const Cell *Row::cells() const
+{
+    return m_cells;
+}
+
+CellLock::CellLock(TextGrid &text_grid) : m_text_grid(&text_grid),
+                                          m_is_locked(true),
+                                          m_has_damage(false)
+{
+    // the cells stay checked out after the mutex is unlocked, so the lock
+    // can be released from any thread
+    auto guard = m_text_grid->lock_rows();
+    m_text_grid->m_is_checked_out = true;
+    m_text_grid->normalize_rows();
+}
+
+CellLock::~CellLock()
+{
+    release();
+}
+
+Cell *CellLock::cells()
+{
+    return m_text_grid->m_cells.data();
+}
+
+Size CellLock::rows() const
+{
+    return m_text_grid->rows();
+}
+
+Size CellLock::cols() const
+{
+    return m_text_grid->cols();
+}
+
+ColorHandle CellLock::color_handle(const Color &color)
+{
+    return m_text_grid->intern_color(color);
+}
+
+void CellLock::damage(Index first_row, Index last_row)
+{
+    first_row = fix_range(first_row, 0, m_text_grid->rows());
+    last_row = fix_range(last_row, 0, m_text_grid->rows());
+    if (last_row > first_row)
+    {
+        m_text_grid->damage(first_row, last_row);
+    }
+
+    m_has_damage = true;
+}
+
+void CellLock::release()
+{
+    if (!m_is_locked.exchange(false))
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_text_grid->m_rows_mutex);
+        if (!m_has_damage)
+        {
+            m_text_grid->damage(0, m_text_grid->rows());
+        }
+
+        m_text_grid->m_is_checked_out = false;
+    }
+
+    m_text_grid->m_cells_returned.notify_all();
+}
+
+bool CellLock::is_locked() const
 {
-    std::fill(begin(), end(), Letter(' ', color));
+    return m_is_locked;
 }
 
-TextGrid::TextGrid(Size rows, Size cols, const std::string &title, const Color &default_color) : m_rows(rows),
+TextGrid::TextGrid(Size rows, Size cols, const std::string &title, const Color &default_color) : m_row_slots(rows),
+                                                                                                 m_default_color(default_color),
+                                                                                                 m_rows(rows),
                                                                                                  m_cols(cols),
                                                                                                  m_title(title),
-                                                                                                 m_default_color(default_color),
-                                                                                                 m_id(-1)
+                                                                                                 m_palette_version(0),
+                                                                                                 m_row_versions(rows, 1),
+                                                                                                 m_version(1),
+                                                                                                 m_shift_floor(0),
+                                                                                                 m_back_frame(0),
+                                                                                                 m_front_frame(1),
+                                                                                                 m_ready_frame(2),
+                                                                                                 m_is_recording(false),
+                                                                                                 m_id(-1),
+                                                                                                 m_serial(g_next_serial.fetch_add(1)),
+                                                                                                 m_is_checked_out(false)
 {
-    for (auto r = 0; r < rows; ++r)
+    m_default_handle = intern_color(default_color);
+    m_color_table.fill(m_default_handle);
+    m_cells.assign(static_cast<std::size_t>(rows) * cols, Cell{' ', m_default_handle});
+    std::iota(m_row_slots.begin(), m_row_slots.end(), 0);
+    for (auto &frame : m_frames)
     {
-        m_grid.emplace_back(cols);
+        frame.cells = m_cells;
+        frame.palette = m_palette;
+        frame.palette_version = m_palette_version;
+        frame.row_versions.assign(rows, 0);
+        frame.version = 0;
+        frame.shift_floor = 0;
     }
 }
 
-TextGrid::TextGrid(TextGrid &&other) : m_rows(other.m_rows),
+TextGrid::TextGrid(TextGrid &&other) : m_cells(std::move(other.m_cells)),
+                                       m_row_slots(std::move(other.m_row_slots)),
+                                       m_layers(std::move(other.m_layers)),
+                                       m_composite(std::move(other.m_composite)),
+                                       m_compose_left(std::move(other.m_compose_left)),
+                                       m_compose_right(std::move(other.m_compose_right)),
+                                       m_palette(std::move(other.m_palette)),
+                                       m_palette_index(std::move(other.m_palette_index)),
+                                       m_color_table(other.m_color_table),
+                                       m_default_color(other.m_default_color),
+                                       m_default_handle(other.m_default_handle),
+                                       m_rows(other.m_rows),
                                        m_cols(other.m_cols),
                                        m_title(std::move(other.m_title)),
-                                       m_default_color(other.m_default_color),
-                                       m_grid(std::move(other.m_grid)),
-                                       m_id(other.m_id)
+                                       m_palette_version(other.m_palette_version),
+                                       m_row_versions(std::move(other.m_row_versions)),
+                                       m_version(other.m_version),
+                                       m_shifts(std::move(other.m_shifts)),
+                                       m_shift_floor(other.m_shift_floor),
+                                       m_frames{std::move(other.m_frames[0]), std::move(other.m_frames[1]), std::move(other.m_frames[2])},
+                                       m_back_frame(other.m_back_frame),
+                                       m_front_frame(other.m_front_frame),
+                                       m_ready_frame(other.m_ready_frame.load()),
+                                       m_recorder(std::move(other.m_recorder)),
+                                       m_is_recording(other.m_is_recording.load()),
+                                       m_draw_queue(std::move(other.m_draw_queue)),
+                                       m_id(other.m_id),
+                                       m_serial(g_next_serial.fetch_add(1)),
+                                       m_is_checked_out(false)
+{
+    for (auto &layer : m_layers)
+    {
+        layer->m_text_grid = this;
+    }
+}
+
+TextGrid::~TextGrid()
 {
+    for (auto &layer : m_layers)
+    {
+        layer->m_text_grid = nullptr;
+    }
 }
 
 std::string TextGrid::to_string() const
@@ -78,157 +231,784 @@ std::string TextGrid::to_string() const
     return stream.str();
 }
 
-const Letter &TextGrid::get_letter(Index row, Index col) const
+Cell *TextGrid::row_cells(Index row)
+{
+    return m_cells.data() + static_cast<std::size_t>(m_row_slots[row]) * m_cols;
+}
+
+const Cell *TextGrid::row_cells(Index row) const
+{
+    return m_cells.data() + static_cast<std::size_t>(m_row_slots[row]) * m_cols;
+}
+
+Cell *TextGrid::row_cells(Cell *plane, Index row) const
+{
+    // only the rows of the grid's own cells are reordered by scrolling
+    Size slot = plane == m_cells.data() ? m_row_slots[row] : row;
+    return plane + static_cast<std::size_t>(slot) * m_cols;
+}
+
+const Cell *TextGrid::presented_row(Index row) const
+{
+    return m_layers.empty() ? row_cells(row) : m_composite.data() + static_cast<std::size_t>(row) * m_cols;
+}
+
+std::unique_lock<std::mutex> TextGrid::lock_rows()
+{
+    // only contended locks are timed, so the common case reads no clocks
+    std::unique_lock<std::mutex> lock(m_rows_mutex, std::try_to_lock);
+    if (!lock.owns_lock() || m_is_checked_out)
+    {
+        PhaseTimer timer(stats_counters().lock_wait);
+        if (!lock.owns_lock())
+        {
+            lock.lock();
+        }
+
+        // the cells may be held by a CellLock, which does not keep the mutex
+        m_cells_returned.wait(lock, [this] { return !m_is_checked_out; });
+    }
+
+    return lock;
+}
+
+FrameView TextGrid::view(const Frame &frame) const
+{
+    return {m_rows, m_cols, frame.cells.data(), &frame.palette, frame.row_versions.data(), frame.version,
+            frame.shifts.data(), frame.shifts.size(), frame.shift_floor};
+}
+
+void TextGrid::normalize_rows()
+{
+    bool is_ordered = true;
+    for (Size row = 0; is_ordered && row < m_rows; ++row)
+    {
+        is_ordered = m_row_slots[row] == row;
+    }
+
+    if (is_ordered)
+    {
+        return;
+    }
+
+    CellBuffer cells(m_cells.size());
+    for (Size row = 0; row < m_rows; ++row)
+    {
+        const Cell *first = row_cells(row);
+        std::copy(first, first + m_cols, cells.begin() + static_cast<std::size_t>(row) * m_cols);
+    }
+
+    m_cells.swap(cells);
+    std::iota(m_row_slots.begin(), m_row_slots.end(), 0);
+}
+
+Letter TextGrid::get_letter(Index row, Index col) const
 {
-    return m_grid[row][col];
+    const Cell &cell = row_cells(row)[col];
+    return Letter(cell.value, m_palette[cell.color]);
 }
 
-const Row &TextGrid::get_row(Index row) const
+Row TextGrid::get_row(Index row) const
 {
-    return m_grid[row];
+    return Row(row_cells(row), m_cols, m_palette);
 }
 
 TextGrid &TextGrid::draw(Index row, Index col, const std::string &values)
 {
-    std::lock_guard<std::mutex> guard(m_rows_mutex);
+    auto guard = lock_rows();
+    draw_text(m_cells.data(), row, col, values.data(), values.size());
+    return *this;
+}
+
+TextGrid &TextGrid::draw(Index row, Index col, const std::vector<Letter> &letters)
+{
+    auto guard = lock_rows();
+    draw_letters(m_cells.data(), row, col, letters.data(), letters.size());
+    return *this;
+}
+
+TextGrid &TextGrid::draw(const Rect &rect, char value)
+{
+    auto guard = lock_rows();
+    fill(m_cells.data(), rect, Cell{value, get_color(value)});
+    return *this;
+}
+
+TextGrid &TextGrid::clear(Index row, Index col, Size cols)
+{
+    auto guard = lock_rows();
+    clear_cells(m_cells.data(), row, col, cols, Cell{' ', m_default_handle});
+    return *this;
+}
+
+TextGrid &TextGrid::clear(const Rect &rect)
+{
+    return draw(rect, ' ');
+}
+
+TextGrid &TextGrid::blit_sprite(const Sprite &sprite, Index row, Index col)
+{
+    auto guard = lock_rows();
+    draw_sprite(m_cells.data(), sprite, row, col);
+    return *this;
+}
+
+TextGrid &TextGrid::apply(const DrawBatch &batch)
+{
+    auto guard = lock_rows();
+    apply_batch(m_cells.data(), batch, Cell{' ', m_default_handle});
+    return *this;
+}
+
+TextGrid &TextGrid::apply(DrawQueue &queue)
+{
+    auto guard = lock_rows();
+    apply_queue(queue);
+    return *this;
+}
+
+void TextGrid::set_draw_queue(const std::shared_ptr<DrawQueue> &queue)
+{
+    auto guard = lock_rows();
+    m_draw_queue = queue;
+}
+
+TextGrid &TextGrid::scroll(const Rect &rect, Index rows, Index cols)
+{
+    auto guard = lock_rows();
+    scroll_cells(m_cells.data(), rect, rows, cols, Cell{' ', m_default_handle});
+    return *this;
+}
+
+std::shared_ptr<Layer> TextGrid::add_layer()
+{
+    std::shared_ptr<Layer> layer(new Layer(this));
+    auto guard = lock_rows();
+    if (m_layers.empty())
+    {
+        m_composite.resize(m_cells.size());
+        for (Size row = 0; row < m_rows; ++row)
+        {
+            const Cell *first = row_cells(row);
+            std::copy(first, first + m_cols, m_composite.begin() + static_cast<std::size_t>(row) * m_cols);
+        }
+
+        m_compose_left.assign(m_rows, m_cols);
+        m_compose_right.assign(m_rows, 0);
+    }
+
+    m_layers.push_back(layer);
+    return layer;
+}
+
+void TextGrid::remove_layer(const std::shared_ptr<Layer> &layer)
+{
+    auto guard = lock_rows();
+    auto it = std::find(m_layers.begin(), m_layers.end(), layer);
+    if (it == m_layers.end())
+    {
+        throw std::runtime_error("The layer does not belong to this TextGrid");
+    }
+
+    layer->m_text_grid = nullptr;
+    m_layers.erase(it);
+    if (m_layers.empty())
+    {
+        CellBuffer().swap(m_composite);
+    }
+
+    // every cell the layer covered may now show something else
+    damage(0, m_rows);
+}
+
+void TextGrid::apply_batch(Cell *plane, const DrawBatch &batch, const Cell &blank)
+{
+    for (const auto &command : batch.m_commands)
+    {
+        const char *text = command.op == DrawBatch::Op::TEXT ? batch.m_text.data() + command.offset : nullptr;
+        const Letter *letters = command.op == DrawBatch::Op::LETTERS ? batch.m_letters.data() + command.offset : nullptr;
+        const Sprite *sprite = command.op == DrawBatch::Op::SPRITE ? batch.m_sprites[command.offset] : nullptr;
+        apply_command(plane, command, text, letters, sprite, blank);
+    }
+}
+
+void TextGrid::apply_command(Cell *plane, const DrawBatch::Command &command, const char *text, const Letter *letters,
+                             const Sprite *sprite, const Cell &blank)
+{
+    switch (command.op)
+    {
+    case DrawBatch::Op::TEXT:
+        draw_text(plane, command.row, command.col, text, command.count);
+        break;
+
+    case DrawBatch::Op::LETTERS:
+        draw_letters(plane, command.row, command.col, letters, command.count);
+        break;
+
+    case DrawBatch::Op::FILL:
+        fill(plane, Rect(command.col, command.row, command.width, command.height),
+             Cell{command.value, get_color(command.value)});
+        break;
+
+    case DrawBatch::Op::CLEAR:
+        fill(plane, Rect(command.col, command.row, command.width, command.height), blank);
+        break;
+
+    case DrawBatch::Op::SPRITE:
+        draw_sprite(plane, *sprite, command.row, command.col);
+        break;
+    }
+}
+
+void TextGrid::apply_queue(DrawQueue &queue)
+{
+    // stopping after one lap keeps busy producers from holding the lock forever
+    const Cell blank = {' ', m_default_handle};
+    for (std::size_t i = 0; i < queue.capacity(); ++i)
+    {
+        DrawQueue::Slot *slot = queue.claim();
+        if (!slot)
+        {
+            break;
+        }
+
+        apply_command(m_cells.data(), slot->command, slot->text.data(), slot->letters.data(), nullptr, blank);
+        queue.release(slot);
+    }
+}
+
+void TextGrid::scroll_cells(Cell *plane, const Rect &rect, Index rows, Index cols, const Cell &blank)
+{
+    Rect clip = rect.clip(m_cols, m_rows);
+    if (clip.area() == 0 || (rows == 0 && cols == 0))
+    {
+        return;
+    }
+
+    if (plane == m_cells.data() && cols == 0 && clip.left() == 0 && clip.right() == static_cast<Index>(m_cols))
+    {
+        scroll_rows(clip.top(), clip.bottom(), rows);
+        return;
+    }
+
+    // the columns of each row which receive cells from inside the region
+    int first = std::max<int>(clip.left(), clip.left() + cols);
+    int last = std::min<int>(clip.right(), clip.right() + cols);
+    for (int i = 0; i < clip.height(); ++i)
+    {
+        // rows are moved in an order which never overwrites a source row before it is read
+        int row = rows > 0 ? clip.bottom() - 1 - i : clip.top() + i;
+        int source = row - rows;
+        Cell *cells = row_cells(plane, row);
+        if (source < clip.top() || source >= clip.bottom() || first >= last)
+        {
+            std::fill(cells + clip.left(), cells + clip.right(), blank);
+            continue;
+        }
+
+        std::memmove(cells + first, row_cells(plane, source) + first - cols, (last - first) * sizeof(Cell));
+        std::fill(cells + clip.left(), cells + first, blank);
+        std::fill(cells + last, cells + clip.right(), blank);
+    }
+
+    damage(clip.top(), clip.bottom(), clip.left(), clip.right());
+}
+
+void TextGrid::scroll_rows(Index top, Index bottom, Index rows)
+{
+    int distance = std::min(std::abs(rows), bottom - top);
+    auto first_slot = m_row_slots.begin() + top;
+    auto last_slot = m_row_slots.begin() + bottom;
+    std::rotate(first_slot, rows < 0 ? first_slot + distance : last_slot - distance, last_slot);
+
+    // the rows which scrolled out of the region are reused for the ones exposed
+    int exposed = rows < 0 ? bottom - distance : top;
+    for (int row = exposed; row < exposed + distance; ++row)
+    {
+        Cell *cells = row_cells(row);
+        std::fill(cells, cells + m_cols, Cell{' ', m_default_handle});
+    }
+
+    if (!m_layers.empty() || distance == bottom - top)
+    {
+        damage(top, bottom);
+        return;
+    }
+
+    // the rows keep their versions as they move, so that the copies held by
+    // frames and renderers can be shifted in the same way instead of redrawn
+    auto first_version = m_row_versions.begin() + top;
+    auto last_version = m_row_versions.begin() + bottom;
+    std::rotate(first_version, rows < 0 ? first_version + distance : last_version - distance, last_version);
+    damage(exposed, exposed + distance);
+
+    m_shifts.push_back({m_version, top, bottom, rows});
+    if (m_shifts.size() > MAX_SHIFTS)
+    {
+        m_shift_floor = m_shifts.front().version;
+        m_shifts.erase(m_shifts.begin());
+    }
+}
+
+void TextGrid::draw_text(Cell *plane, Index row, Index col, const char *values, std::size_t count)
+{
     if (row < 0)
     {
         row += m_rows;
     }
 
     Index left = fix_range(col, 0, m_cols);
-    Index right = fix_range(col + Size(values.size()), 0, m_cols);
-    auto first = values.begin() + (left - col);
-    auto last = first + (right - left);
-    std::vector<Letter> letters;
-    std::transform(first, last, std::back_inserter(letters),
-                   [this](char value) -> Letter { return Letter(value, get_color(value)); });
-    std::copy(letters.begin(), letters.end(), m_grid[row].begin() + left);
-    return *this;
+    Index right = fix_range(col + Size(count), 0, m_cols);
+    const char *first = values + (left - col);
+    const char *last = first + (right - left);
+    const ColorHandle *colors = m_color_table.data();
+    std::transform(first, last, row_cells(plane, row) + left, [colors](char value) -> Cell {
+        return Cell{value, colors[static_cast<std::uint8_t>(value)]};
+    });
+    if (right > left)
+    {
+        damage(row, row + 1, left, right);
+    }
 }
 
-TextGrid &TextGrid::draw(Index row, Index col, const std::vector<Letter> &letters)
+void TextGrid::draw_letters(Cell *plane, Index row, Index col, const Letter *letters, std::size_t count)
 {
-    std::lock_guard<std::mutex> guard(m_rows_mutex);
     if (row < 0)
     {
         row += m_rows;
     }
 
     Index left = fix_range(col, 0, m_cols);
-    Index right = fix_range(col + Size(letters.size()), 0, m_cols);
-    auto first = letters.begin() + (left - col);
-    auto last = first + (right - left);
-    std::copy(first, last, m_grid[row].begin() + left);
-    return *this;
+    Index right = fix_range(col + Size(count), 0, m_cols);
+    const Letter *first = letters + (left - col);
+    const Letter *last = first + (right - left);
+    Cell *cells = row_cells(plane, row) + left;
+    for (auto letter = first; letter < last; ++letter, ++cells)
+    {
+        *cells = Cell{letter->value(), intern_color(letter->color())};
+    }
+
+    if (right > left)
+    {
+        damage(row, row + 1, left, right);
+    }
 }
 
-TextGrid &TextGrid::draw(const Rect &rect, char value)
+void TextGrid::fill(Cell *plane, const Rect &rect, const Cell &cell)
 {
-    std::lock_guard<std::mutex> guard(m_rows_mutex);
-    Letter letter(value, get_color(value));
     Rect clip = rect.clip(m_cols, m_rows);
     if (clip.area() == 0)
     {
-        return *this;
+        return;
     }
 
-    auto top = m_grid.begin() + clip.top();
-    auto bottom = m_grid.begin() + clip.bottom();
-    for (auto row = top; row < bottom; ++row)
+    for (auto row = clip.top(); row < clip.bottom(); ++row)
     {
-        auto left = row->begin() + clip.left();
-        auto right = row->begin() + clip.right();
-        std::fill(left, right, letter);
+        Cell *cells = row_cells(plane, row);
+        std::fill(cells + clip.left(), cells + clip.right(), cell);
     }
 
-    return *this;
+    damage(clip.top(), clip.bottom(), clip.left(), clip.right());
 }
 
-TextGrid &TextGrid::clear(Index row, Index col, Size cols)
+void TextGrid::clear_cells(Cell *plane, Index row, Index col, Size cols, const Cell &blank)
 {
-    std::lock_guard<std::mutex> guard(m_rows_mutex);
-    // TODO create function for this
     Index left = fix_range(col, 0, m_cols);
     Index right = fix_range(col + cols, 0, m_cols);
     if (right - left == 0)
     {
-        return *this;
+        return;
     }
 
-    auto first = m_grid[row].begin() + (left - col);
-    auto last = first + (right - left);
-    std::fill(first, last, Letter());
-
-    return *this;
+    Cell *cells = row_cells(plane, row);
+    std::fill(cells + left, cells + right, blank);
+    damage(row, row + 1, left, right);
 }
 
-TextGrid &TextGrid::clear(const Rect &rect)
+void TextGrid::draw_sprite(Cell *plane, const Sprite &sprite, Index row, Index col)
 {
-    return draw(rect, ' ');
+    intern_colors(sprite.m_palette, m_sprite_handles);
+
+    int first_row = m_rows;
+    int last_row = 0;
+    int first_col = m_cols;
+    int last_col = 0;
+    for (const auto &run : sprite.m_runs)
+    {
+        int target_row = row + run.row;
+        if (target_row < 0 || target_row >= m_rows)
+        {
+            continue;
+        }
+
+        int left = std::max(col + run.col, 0);
+        int right = std::min(col + run.col + run.length, static_cast<int>(m_cols));
+        if (right <= left)
+        {
+            continue;
+        }
+
+        const Cell *first = sprite.m_cells.data() + run.offset + (left - col - run.col);
+        const Cell *last = first + (right - left);
+        std::transform(first, last, row_cells(plane, target_row) + left, [this](const Cell &cell) -> Cell {
+            return Cell{cell.value, cell.color == Sprite::MAPPED ? get_color(cell.value) : m_sprite_handles[cell.color]};
+        });
+        first_row = std::min(first_row, target_row);
+        last_row = std::max(last_row, target_row + 1);
+        first_col = std::min(first_col, left);
+        last_col = std::max(last_col, right);
+    }
+
+    if (last_row > first_row)
+    {
+        damage(first_row, last_row, first_col, last_col);
+    }
 }
 
 TextGrid &TextGrid::map_color(char value, const Color &color)
 {
-    m_color_map[value] = color;
+    auto guard = lock_rows();
+    m_color_table[static_cast<std::uint8_t>(value)] = intern_color(color);
     return *this;
 }
 
 TextGrid &TextGrid::unmap_color(char value)
 {
-    m_color_map.erase(value);
+    auto guard = lock_rows();
+    m_color_table[static_cast<std::uint8_t>(value)] = m_default_handle;
+    return *this;
+}
+
+TextGrid &TextGrid::recolor(const Rect &rect)
+{
+    auto guard = lock_rows();
+    recolor_cells(m_cells.data(), rect);
     return *this;
 }
 
-const Color &TextGrid::get_color(char value) const
+void TextGrid::recolor_cells(Cell *plane, const Rect &rect)
 {
-    if (m_color_map.count(value))
+    Rect clip = rect.clip(m_cols, m_rows);
+    if (clip.area() == 0)
+    {
+        return;
+    }
+
+    const ColorHandle *colors = m_color_table.data();
+    for (auto row = clip.top(); row < clip.bottom(); ++row)
     {
-        return m_color_map.at(value);
+        Cell *cells = row_cells(plane, row);
+        for (auto col = clip.left(); col < clip.right(); ++col)
+        {
+            cells[col].color = colors[static_cast<std::uint8_t>(cells[col].value)];
+        }
     }
 
-    return m_default_color;
+    damage(clip.top(), clip.bottom(), clip.left(), clip.right());
+}
+
+ColorHandle TextGrid::get_color(char value) const
+{
+    return m_color_table[static_cast<std::uint8_t>(value)];
 }
 
-void TextGrid::draw_rows()
+ColorHandle TextGrid::intern_color(const Color &color)
 {
-    std::lock_guard<std::mutex> guard(m_rows_mutex);
-    float y = 15;
-    for (auto &row : m_grid)
+    auto it = m_palette_index.find(color.rgba());
+    if (it != m_palette_index.end())
     {
-        float x = 0;
-        for (auto &letter : row)
+        return it->second;
+    }
+
+    if (m_palette.size() > std::numeric_limits<ColorHandle>::max())
+    {
+        compact_palette();
+        if (m_palette.size() > std::numeric_limits<ColorHandle>::max())
         {
-            if (letter.value() == ' ')
+            throw std::length_error("Too many distinct colors in use for a single TextGrid");
+        }
+    }
+
+    ColorHandle handle = static_cast<ColorHandle>(m_palette.size());
+    m_palette.push_back(color);
+    m_palette_index[color.rgba()] = handle;
+    ++m_palette_version;
+    return handle;
+}
+
+void TextGrid::intern_colors(const std::vector<Color> &colors, std::vector<ColorHandle> &handles)
+{
+    // compacting part way through would remap the handles already interned,
+    // so room is made for every color before any of them are added
+    std::size_t missing = std::count_if(colors.begin(), colors.end(), [this](const Color &color) {
+        return m_palette_index.find(color.rgba()) == m_palette_index.end();
+    });
+
+    const std::size_t limit = static_cast<std::size_t>(std::numeric_limits<ColorHandle>::max()) + 1;
+    if (m_palette.size() + missing > limit)
+    {
+        compact_palette();
+        if (m_palette.size() + missing > limit)
+        {
+            throw std::length_error("Too many distinct colors in use for a single TextGrid");
+        }
+    }
+
+    handles.resize(colors.size());
+    for (std::size_t i = 0; i < colors.size(); ++i)
+    {
+        handles[i] = intern_color(colors[i]);
+    }
+}
+
+void TextGrid::compact_palette()
+{
+    std::vector<ColorHandle> remap(m_palette.size(), 0);
+    std::vector<bool> used(m_palette.size(), false);
+    used[m_default_handle] = true;
+    for (auto handle : m_color_table)
+    {
+        used[handle] = true;
+    }
+
+    for (auto &cell : m_cells)
+    {
+        used[cell.color] = true;
+    }
+
+    for (auto &layer : m_layers)
+    {
+        for (auto &cell : layer->m_cells)
+        {
+            if (cell.value != Layer::TRANSPARENT)
             {
-                x += COLW;
-                continue;
+                used[cell.color] = true;
             }
+        }
+    }
+
+    std::vector<Color> palette;
+    m_palette_index.clear();
+    for (std::size_t i = 0; i < m_palette.size(); ++i)
+    {
+        if (used[i])
+        {
+            remap[i] = static_cast<ColorHandle>(palette.size());
+            m_palette_index[m_palette[i].rgba()] = remap[i];
+            palette.push_back(m_palette[i]);
+        }
+    }
+
+    m_palette = std::move(palette);
+    ++m_palette_version;
+    m_default_handle = remap[m_default_handle];
+    for (auto &handle : m_color_table)
+    {
+        handle = remap[handle];
+    }
+
+    for (auto &cell : m_cells)
+    {
+        cell.color = remap[cell.color];
+    }
 
-            glColor3f(letter.color().red(),
-                      letter.color().green(),
-                      letter.color().blue());
-            glRasterPos2f(x, y);
-            glutBitmapCharacter(GLUT_BITMAP_9_BY_15, letter.value());
-            x += COLW;
+    for (auto &layer : m_layers)
+    {
+        for (auto &cell : layer->m_cells)
+        {
+            cell.color = remap[cell.color];
         }
+    }
 
-        y += ROWH;
+    // the composite only holds cells from the planes above
+    for (auto &cell : m_composite)
+    {
+        cell.color = remap[cell.color];
     }
 
-    m_is_dirty = false;
+    // every published cell uses the old handles, so all rows are resent even
+    // though the composite itself does not change
+    std::fill(m_row_versions.begin(), m_row_versions.end(), m_version);
+}
+
+void TextGrid::damage(Index first_row, Index last_row)
+{
+    damage(first_row, last_row, 0, m_cols);
+}
+
+void TextGrid::damage(Index first_row, Index last_row, Index left, Index right)
+{
+    add_count(stats_counters().cells_drawn, static_cast<std::uint64_t>(last_row - first_row) * (right - left));
+    if (m_layers.empty())
+    {
+        std::fill(m_row_versions.begin() + first_row, m_row_versions.begin() + last_row, m_version);
+        return;
+    }
+
+    // the rows are only marked once compose() finds that the cells shown changed
+    for (Index row = first_row; row < last_row; ++row)
+    {
+        m_compose_left[row] = std::min(m_compose_left[row], left);
+        m_compose_right[row] = std::max(m_compose_right[row], right);
+    }
+}
+
+void TextGrid::compose()
+{
+    for (Size row = 0; row < m_rows; ++row)
+    {
+        Index left = m_compose_left[row];
+        Index right = m_compose_right[row];
+        if (right <= left)
+        {
+            continue;
+        }
+
+        std::size_t offset = static_cast<std::size_t>(row) * m_cols;
+        const Cell *base = row_cells(row);
+        Cell *composite = m_composite.data() + offset;
+        bool is_changed = false;
+        for (Index col = left; col < right; ++col)
+        {
+            // the topmost opaque layer wins, with the grid itself at the bottom
+            Cell cell = base[col];
+            for (auto layer = m_layers.rbegin(); layer != m_layers.rend(); ++layer)
+            {
+                const Cell &top = (*layer)->m_cells[offset + col];
+                if (top.value != Layer::TRANSPARENT)
+                {
+                    cell = top;
+                    break;
+                }
+            }
+
+            if (cell.value != composite[col].value || cell.color != composite[col].color)
+            {
+                composite[col] = cell;
+                is_changed = true;
+            }
+        }
+
+        if (is_changed)
+        {
+            m_row_versions[row] = m_version;
+        }
+
+        m_compose_left[row] = m_cols;
+        m_compose_right[row] = 0;
+    }
+}
+
+void TextGrid::draw_rows(FrameRenderer &renderer)
+{
+    if (m_ready_frame.load() & FRESH_FRAME)
+    {
+        m_front_frame = m_ready_frame.exchange(m_front_frame, std::memory_order_acq_rel) & FRAME_INDEX_MASK;
+        add_count(stats_counters().frames_presented);
+    }
+
+    PhaseTimer timer(stats_counters().draw_rows);
+    const Frame &frame = m_frames[m_front_frame];
+    renderer.render(view(frame));
 }
 
 void TextGrid::blit()
 {
-    std::lock_guard<std::mutex> guard(m_rows_mutex);
-    m_is_dirty = true;
+    auto guard = lock_rows();
+    PhaseTimer timer(stats_counters().blit);
+    add_count(stats_counters().frames_blitted);
+    if (m_draw_queue)
+    {
+        apply_queue(*m_draw_queue);
+    }
+
+    if (!m_layers.empty())
+    {
+        compose();
+    }
+
+    Frame &frame = m_frames[m_back_frame];
+    frame.shifts = m_shifts;
+    frame.shift_floor = m_shift_floor;
+
+    // the back frame holds the grid as it was at its own version, so only
+    // the rows modified since then need to be copied into it once the rows
+    // scrolled since then have been moved
+    bool is_shifted = replay_shifts(view(frame), frame.version, frame.cells.data(), m_cols);
+    for (Size row = 0; row < m_rows; ++row)
+    {
+        if (!is_shifted || m_row_versions[row] > frame.version)
+        {
+            const Cell *cells = presented_row(row);
+            std::copy(cells, cells + m_cols, frame.cells.begin() + static_cast<std::size_t>(row) * m_cols);
+        }
+    }
+
+    if (frame.palette_version != m_palette_version)
+    {
+        frame.palette = m_palette;
+        frame.palette_version = m_palette_version;
+    }
+
+    frame.row_versions = m_row_versions;
+    frame.version = m_version;
+    if (m_recorder)
+    {
+        m_recorder->record(view(frame), m_palette_version);
+    }
+
+    ++m_version;
+
+    std::uint32_t replaced = m_ready_frame.exchange(m_back_frame | FRESH_FRAME, std::memory_order_acq_rel);
+    if (replaced & FRESH_FRAME)
+    {
+        add_count(stats_counters().frames_dropped);
+    }
+
+    m_back_frame = replaced & FRAME_INDEX_MASK;
+    render_thread_wakeup().notify();
+}
+
+void TextGrid::start_recording(const std::string &path, std::uint32_t keyframe_interval)
+{
+    auto recorder = std::make_unique<FrameRecorder>(path, m_rows, m_cols, keyframe_interval);
+    {
+        auto guard = lock_rows();
+        m_recorder.swap(recorder);
+        m_is_recording = true;
+    }
+
+    // the replaced recording is finished without holding the grid
+    if (recorder)
+    {
+        recorder->finish();
+    }
+}
+
+void TextGrid::stop_recording()
+{
+    std::unique_ptr<FrameRecorder> recorder;
+    {
+        auto guard = lock_rows();
+        recorder.swap(m_recorder);
+        m_is_recording = false;
+    }
+
+    if (recorder)
+    {
+        recorder->finish();
+    }
+}
+
+bool TextGrid::is_recording() const
+{
+    // m_recorder belongs to whoever holds the grid, so this is kept beside it
+    return m_is_recording;
 }
 
 bool TextGrid::is_dirty()
 {
-    std::lock_guard<std::mutex> guard(m_rows_mutex);
-    return m_is_dirty;
+    return (m_ready_frame.load() & FRESH_FRAME) != 0;
 }
 
 Size TextGrid::cols() const
@@ -0,0 +1,43 @@
+#ifndef _GK_TILE_MAP_H_
+#define _GK_TILE_MAP_H_
+
+#include "glasskey/recording.h"
+
+namespace gk
+{
+/** Layout of the files written by TileMapWriter. Values are little-endian,
+ *  encoded with recording::put() and read with recording::get().
+ *
+ *  The file begins with a header:
+ *
+ *      char[4]  magic "GKMP"
+ *      uint16   format version
+ *      uint16   tile size, equal to WORLD_CHUNK_SIZE
+ *      uint32   rows
+ *      uint32   cols
+ *      uint64   file offset of the tile index
+ *      uint64   file offset of the palette
+ *
+ *  The map is divided into square tiles, stored row-major by tile. Each tile
+ *  which holds anything other than blanks is stored once, at an offset which
+ *  is a multiple of TILE_ALIGNMENT so that it spans as few pages as possible,
+ *  as tile size * tile size cells in row-major order. Every cell is stored as
+ *  its ASCII value (uint8) followed by its palette handle (uint16). Cells of
+ *  the last row and column of tiles which fall outside the map are blank.
+ *
+ *  The tile index holds one uint64 file offset per tile, in the same order,
+ *  with 0 for tiles which are entirely blank and so not stored. The palette
+ *  is a uint32 count followed by count packed RGBA8 colors (uint32); handle
+ *  0 is the color of blank cells.
+ */
+namespace tile_map
+{
+const char MAGIC[4] = {'G', 'K', 'M', 'P'};
+const std::uint16_t VERSION = 1;
+const std::size_t HEADER_SIZE = 32;
+const std::size_t CELL_SIZE = 3;
+const std::size_t TILE_ALIGNMENT = 4096;
+} // namespace tile_map
+} // namespace gk
+
+#endif
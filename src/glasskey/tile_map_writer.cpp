@@ -0,0 +1,185 @@
+#include "glasskey/glasskey.h"
+#include "glasskey/tile_map.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+namespace gk
+{
+TileMapWriter::TileMapWriter(const std::string &path, std::uint32_t rows, std::uint32_t cols,
+                             const Color &default_color) : m_file(path, std::ios::binary | std::ios::trunc),
+                                                           m_rows(rows),
+                                                           m_cols(cols),
+                                                           m_row(0),
+                                                           m_offset(tile_map::HEADER_SIZE),
+                                                           m_palette{default_color},
+                                                           m_is_open(true)
+{
+    if (!m_file)
+    {
+        throw std::runtime_error("Unable to open " + path + " for writing");
+    }
+
+    // the header is written by close(), once the offsets are known
+    m_palette_index[default_color.rgba()] = 0;
+    std::size_t tile_cols = (static_cast<std::size_t>(cols) + WORLD_CHUNK_SIZE - 1) / WORLD_CHUNK_SIZE;
+    m_band.assign(tile_cols * WORLD_CHUNK_SIZE * WORLD_CHUNK_SIZE, Cell{' ', 0});
+    m_buffer.assign(tile_map::HEADER_SIZE, 0);
+    m_file.write(m_buffer.data(), m_buffer.size());
+}
+
+TileMapWriter::~TileMapWriter()
+{
+    try
+    {
+        close();
+    }
+    catch (const std::exception &)
+    {
+        // errors can only be reported by calling close() directly
+    }
+}
+
+Cell *TileMapWriter::next_row()
+{
+    if (!m_is_open || m_row >= m_rows)
+    {
+        throw std::out_of_range("All of the rows of the tile map have been written");
+    }
+
+    std::size_t band_cols = m_band.size() / WORLD_CHUNK_SIZE;
+    return m_band.data() + (m_row % WORLD_CHUNK_SIZE) * band_cols;
+}
+
+void TileMapWriter::write_row(const std::string &values)
+{
+    Cell *cells = next_row();
+    std::size_t count = std::min<std::size_t>(values.size(), m_cols);
+    std::transform(values.begin(), values.begin() + count, cells, [](char value) -> Cell { return Cell{value, 0}; });
+    if (++m_row % WORLD_CHUNK_SIZE == 0 || m_row == m_rows)
+    {
+        flush_band();
+    }
+}
+
+void TileMapWriter::write_row(const std::vector<Letter> &letters)
+{
+    Cell *cells = next_row();
+    std::size_t count = std::min<std::size_t>(letters.size(), m_cols);
+    for (std::size_t col = 0; col < count; ++col)
+    {
+        const Letter &letter = letters[col];
+        auto it = m_palette_index.find(letter.color().rgba());
+        if (it == m_palette_index.end())
+        {
+            if (m_palette.size() > std::numeric_limits<ColorHandle>::max())
+            {
+                throw std::length_error("Too many distinct colors in use for a single tile map");
+            }
+
+            it = m_palette_index.emplace(letter.color().rgba(), static_cast<ColorHandle>(m_palette.size())).first;
+            m_palette.push_back(letter.color());
+        }
+
+        cells[col] = Cell{letter.value(), it->second};
+    }
+
+    if (++m_row % WORLD_CHUNK_SIZE == 0 || m_row == m_rows)
+    {
+        flush_band();
+    }
+}
+
+void TileMapWriter::flush_band()
+{
+    const std::size_t band_cols = m_band.size() / WORLD_CHUNK_SIZE;
+    for (std::size_t left = 0; left < band_cols; left += WORLD_CHUNK_SIZE)
+    {
+        bool is_blank = true;
+        for (std::size_t row = 0; row < WORLD_CHUNK_SIZE && is_blank; ++row)
+        {
+            const Cell *cells = m_band.data() + row * band_cols + left;
+            is_blank = std::all_of(cells, cells + WORLD_CHUNK_SIZE,
+                                   [](const Cell &cell) { return cell.value == ' ' && cell.color == 0; });
+        }
+
+        if (is_blank)
+        {
+            m_index.push_back(0);
+            continue;
+        }
+
+        // each tile starts on a page of its own
+        m_buffer.clear();
+        std::size_t padding = (tile_map::TILE_ALIGNMENT - m_offset % tile_map::TILE_ALIGNMENT) % tile_map::TILE_ALIGNMENT;
+        m_buffer.resize(padding, 0);
+        m_index.push_back(m_offset + padding);
+        for (std::size_t row = 0; row < WORLD_CHUNK_SIZE; ++row)
+        {
+            const Cell *cells = m_band.data() + row * band_cols + left;
+            for (std::size_t col = 0; col < WORLD_CHUNK_SIZE; ++col)
+            {
+                m_buffer.push_back(cells[col].value);
+                recording::put<std::uint16_t>(m_buffer, cells[col].color);
+            }
+        }
+
+        m_file.write(m_buffer.data(), m_buffer.size());
+        m_offset += m_buffer.size();
+    }
+
+    std::fill(m_band.begin(), m_band.end(), Cell{' ', 0});
+}
+
+void TileMapWriter::close()
+{
+    if (!m_is_open)
+    {
+        return;
+    }
+
+    // rows which were never written are blank
+    if (m_row < m_rows)
+    {
+        flush_band();
+        std::size_t tile_cols = m_band.size() / (WORLD_CHUNK_SIZE * WORLD_CHUNK_SIZE);
+        std::size_t tile_rows = (static_cast<std::size_t>(m_rows) + WORLD_CHUNK_SIZE - 1) / WORLD_CHUNK_SIZE;
+        m_index.resize(tile_rows * tile_cols, 0);
+        m_row = m_rows;
+    }
+
+    m_is_open = false;
+    std::uint64_t index_offset = m_offset;
+    m_buffer.clear();
+    for (std::uint64_t offset : m_index)
+    {
+        recording::put<std::uint64_t>(m_buffer, offset);
+    }
+
+    std::uint64_t palette_offset = index_offset + m_buffer.size();
+    recording::put<std::uint32_t>(m_buffer, static_cast<std::uint32_t>(m_palette.size()));
+    for (const Color &color : m_palette)
+    {
+        recording::put<std::uint32_t>(m_buffer, color.rgba());
+    }
+
+    m_file.write(m_buffer.data(), m_buffer.size());
+
+    m_buffer.assign(std::begin(tile_map::MAGIC), std::end(tile_map::MAGIC));
+    recording::put<std::uint16_t>(m_buffer, tile_map::VERSION);
+    recording::put<std::uint16_t>(m_buffer, static_cast<std::uint16_t>(WORLD_CHUNK_SIZE));
+    recording::put<std::uint32_t>(m_buffer, m_rows);
+    recording::put<std::uint32_t>(m_buffer, m_cols);
+    recording::put<std::uint64_t>(m_buffer, index_offset);
+    recording::put<std::uint64_t>(m_buffer, palette_offset);
+    m_file.seekp(0);
+    m_file.write(m_buffer.data(), m_buffer.size());
+    m_file.close();
+    if (m_file.fail())
+    {
+        throw std::runtime_error("Unable to write the tile map");
+    }
+}
+} // namespace gk
@@ -0,0 +1,138 @@
+#include "glasskey/wakeup.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <GL/glx.h>
+#include <X11/Xlib.h>
+#endif
+
+namespace gk
+{
+#ifdef _WIN32
+
+Wakeup::Wakeup() : m_is_pending(false), m_event(CreateEvent(nullptr, TRUE, FALSE, nullptr))
+{
+}
+
+Wakeup::~Wakeup()
+{
+    CloseHandle(m_event);
+}
+
+void Wakeup::notify()
+{
+    if (!m_is_pending.exchange(true))
+    {
+        SetEvent(m_event);
+    }
+}
+
+void Wakeup::reset()
+{
+    ResetEvent(m_event);
+    m_is_pending.store(false);
+}
+
+void Wakeup::wait(bool window_system)
+{
+    HANDLE event = m_event;
+    if (window_system)
+    {
+        MsgWaitForMultipleObjectsEx(1, &event, INFINITE, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+    }
+    else
+    {
+        WaitForSingleObject(event, INFINITE);
+    }
+}
+
+#else
+
+Wakeup::Wakeup() : m_is_pending(false), m_read_fd(-1), m_write_fd(-1), m_display(nullptr)
+{
+    int fds[2];
+    if (pipe(fds) == 0)
+    {
+        fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+        fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+        m_read_fd = fds[0];
+        m_write_fd = fds[1];
+    }
+}
+
+Wakeup::~Wakeup()
+{
+    close(m_read_fd);
+    close(m_write_fd);
+}
+
+void Wakeup::notify()
+{
+    if (!m_is_pending.exchange(true))
+    {
+        char byte = 1;
+        while (write(m_write_fd, &byte, 1) < 0 && errno == EINTR)
+        {
+        }
+    }
+}
+
+void Wakeup::reset()
+{
+    // drain first, then clear the flag: a notify() racing with this either
+    // sees the flag still set and its work is picked up by the caller's
+    // check, or it writes a fresh byte which ends the next wait()
+    char buffer[64];
+    while (read(m_read_fd, buffer, sizeof(buffer)) > 0)
+    {
+    }
+
+    m_is_pending.store(false);
+}
+
+void Wakeup::wait(bool window_system)
+{
+    if (window_system)
+    {
+        Display *current = glXGetCurrentDisplay();
+        if (current)
+        {
+            m_display = current;
+        }
+    }
+
+    pollfd fds[2] = {{m_read_fd, POLLIN, 0}, {-1, POLLIN, 0}};
+    nfds_t num_fds = 1;
+    if (window_system && m_display)
+    {
+        Display *display = static_cast<Display *>(m_display);
+        XFlush(display);
+        if (XPending(display))
+        {
+            return;
+        }
+
+        fds[1].fd = ConnectionNumber(display);
+        num_fds = 2;
+    }
+
+    while (poll(fds, num_fds, -1) < 0 && errno == EINTR)
+    {
+    }
+}
+
+#endif
+
+Wakeup &render_thread_wakeup()
+{
+    static Wakeup wakeup;
+    return wakeup;
+}
+} // namespace gk
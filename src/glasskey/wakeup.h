@@ -0,0 +1,50 @@
+#ifndef _GK_WAKEUP_H_
+#define _GK_WAKEUP_H_
+
+#include <atomic>
+
+namespace gk
+{
+/** Lets any thread wake the render thread while it is blocked waiting
+ *  for window system events.
+ */
+class Wakeup
+{
+public:
+    /** Constructor. */
+    Wakeup();
+
+    /** Destructor. */
+    ~Wakeup();
+
+    /** Wakes the render thread. Never blocks, and may be called from any thread. */
+    void notify();
+
+    /** Discards pending notifications. The render thread must call this before
+     *  it checks for work, so that work published afterwards is not missed.
+     */
+    void reset();
+
+    /** Blocks the render thread until notify() is called or, optionally, the
+     *  window system has events waiting to be processed.
+     *
+     *  \param window_system whether to also wake for window system events
+     */
+    void wait(bool window_system);
+
+private:
+    std::atomic_bool m_is_pending;
+#ifdef _WIN32
+    void *m_event;
+#else
+    int m_read_fd;
+    int m_write_fd;
+    void *m_display;
+#endif
+};
+
+/** The wakeup used by the render thread */
+Wakeup &render_thread_wakeup();
+} // namespace gk
+
+#endif
@@ -0,0 +1,107 @@
+#include "glasskey/worker_pool.h"
+
+#include <algorithm>
+
+namespace gk
+{
+WorkerPool::WorkerPool(unsigned threads) : m_task(nullptr),
+                                           m_tasks(0),
+                                           m_next_task(0),
+                                           m_job(0),
+                                           m_busy(0),
+                                           m_is_stopping(false)
+{
+    for (unsigned i = 1; i < threads; ++i)
+    {
+        m_threads.emplace_back(&WorkerPool::work, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_is_stopping = true;
+    }
+
+    m_job_ready.notify_all();
+    for (auto &thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+unsigned WorkerPool::threads() const
+{
+    return static_cast<unsigned>(m_threads.size()) + 1;
+}
+
+void WorkerPool::run(std::size_t tasks, const std::function<void(std::size_t)> &task)
+{
+    if (m_threads.empty() || tasks < 2)
+    {
+        for (std::size_t i = 0; i < tasks; ++i)
+        {
+            task(i);
+        }
+
+        return;
+    }
+
+    std::lock_guard<std::mutex> run_guard(m_run_mutex);
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_task = &task;
+        m_tasks = tasks;
+        m_next_task.store(0, std::memory_order_relaxed);
+        m_busy = static_cast<unsigned>(m_threads.size());
+        ++m_job;
+    }
+
+    m_job_ready.notify_all();
+    take_tasks();
+
+    // the job must not go out of scope while a worker may still be reading it
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_job_done.wait(lock, [this] { return m_busy == 0; });
+    m_task = nullptr;
+}
+
+void WorkerPool::take_tasks()
+{
+    std::size_t i;
+    while ((i = m_next_task.fetch_add(1, std::memory_order_relaxed)) < m_tasks)
+    {
+        (*m_task)(i);
+    }
+}
+
+void WorkerPool::work()
+{
+    std::uint64_t job = 0;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_job_ready.wait(lock, [this, job] { return m_is_stopping || m_job != job; });
+        if (m_is_stopping)
+        {
+            return;
+        }
+
+        job = m_job;
+        lock.unlock();
+        take_tasks();
+        lock.lock();
+        if (--m_busy == 0)
+        {
+            m_job_done.notify_one();
+        }
+    }
+}
+
+WorkerPool &render_pool()
+{
+    static WorkerPool pool(std::max(1u, std::thread::hardware_concurrency()));
+    return pool;
+}
+} // namespace gk
@@ -0,0 +1,67 @@
+#ifndef _GK_WORKER_POOL_H_
+#define _GK_WORKER_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gk
+{
+/** A fixed set of threads which run the tasks of one job at a time. The
+ *  thread which submits a job works on it too, so a pool of one thread
+ *  runs every task inline.
+ */
+class WorkerPool
+{
+public:
+    /** Constructor.
+     *
+     *  \param threads the number of threads working on each job, including
+     *                 the caller of run()
+     */
+    explicit WorkerPool(unsigned threads);
+
+    /** Destructor. Stops the threads. */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    /** Runs a job and blocks until all of its tasks are done. Jobs submitted
+     *  from several threads run one after the other.
+     *
+     *  \param tasks the number of tasks in the job
+     *  \param task called once with each task index, from any of the threads
+     */
+    void run(std::size_t tasks, const std::function<void(std::size_t)> &task);
+
+    /** The number of threads working on each job */
+    unsigned threads() const;
+
+private:
+    void work();
+    void take_tasks();
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_run_mutex;
+    std::mutex m_mutex;
+    std::condition_variable m_job_ready;
+    std::condition_variable m_job_done;
+    const std::function<void(std::size_t)> *m_task;
+    std::size_t m_tasks;
+    std::atomic<std::size_t> m_next_task;
+    std::uint64_t m_job;
+    unsigned m_busy;
+    bool m_is_stopping;
+};
+
+/** The pool shared by the CPU renderers, with a thread for each core */
+WorkerPool &render_pool();
+} // namespace gk
+
+#endif
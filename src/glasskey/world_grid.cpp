@@ -0,0 +1,296 @@
+#include "glasskey/glasskey.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+const std::int64_t MIN_COORD = std::numeric_limits<std::int32_t>::min();
+const std::int64_t END_COORD = static_cast<std::int64_t>(std::numeric_limits<std::int32_t>::max()) + 1;
+
+/** The chunk holding a row or column, rounding towards negative infinity */
+std::int64_t chunk_of(std::int64_t coord)
+{
+    return (coord >= 0 ? coord : coord - (gk::WORLD_CHUNK_SIZE - 1)) / gk::WORLD_CHUNK_SIZE;
+}
+
+/** The offset of a row or column within its chunk */
+std::int32_t offset_in_chunk(std::int64_t coord)
+{
+    return static_cast<std::int32_t>(coord - chunk_of(coord) * gk::WORLD_CHUNK_SIZE);
+}
+
+bool is_blank(const gk::Cell &cell)
+{
+    return cell.value == ' ' && cell.color == 0;
+}
+} // namespace
+
+namespace gk
+{
+WorldGrid::WorldGrid(const Color &default_color)
+{
+    intern_color(default_color);
+}
+
+std::uint64_t WorldGrid::chunk_key(std::int32_t chunk_row, std::int32_t chunk_col)
+{
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunk_row)) << 32) |
+           static_cast<std::uint32_t>(chunk_col);
+}
+
+ColorHandle WorldGrid::intern_color(const Color &color)
+{
+    auto it = m_palette_index.find(color.rgba());
+    if (it != m_palette_index.end())
+    {
+        return it->second;
+    }
+
+    if (m_palette.size() > std::numeric_limits<ColorHandle>::max())
+    {
+        throw std::length_error("Too many distinct colors in use for a single WorldGrid");
+    }
+
+    ColorHandle handle = static_cast<ColorHandle>(m_palette.size());
+    m_palette.push_back(color);
+    m_palette_index[color.rgba()] = handle;
+    return handle;
+}
+
+const Cell *WorldGrid::find_row(std::int32_t row, std::int32_t col) const
+{
+    auto it = m_chunks.find(chunk_key(static_cast<std::int32_t>(chunk_of(row)), static_cast<std::int32_t>(chunk_of(col))));
+    if (it == m_chunks.end())
+    {
+        return nullptr;
+    }
+
+    return it->second->cells + offset_in_chunk(row) * WORLD_CHUNK_SIZE + offset_in_chunk(col);
+}
+
+Cell *WorldGrid::row_span(std::int32_t row, std::int32_t col)
+{
+    auto &chunk = m_chunks[chunk_key(static_cast<std::int32_t>(chunk_of(row)), static_cast<std::int32_t>(chunk_of(col)))];
+    if (!chunk)
+    {
+        chunk = std::make_unique<Chunk>();
+        std::fill(std::begin(chunk->cells), std::end(chunk->cells), Cell{' ', 0});
+    }
+
+    chunk->is_modified = true;
+    return chunk->cells + offset_in_chunk(row) * WORLD_CHUNK_SIZE + offset_in_chunk(col);
+}
+
+void WorldGrid::draw_cells(std::int32_t row, std::int32_t col, const Cell *cells, std::size_t count)
+{
+    std::int64_t end = std::min<std::int64_t>(col + static_cast<std::int64_t>(count), END_COORD);
+    for (std::int64_t start = col; start < end;)
+    {
+        std::int64_t run = std::min<std::int64_t>(WORLD_CHUNK_SIZE - offset_in_chunk(start), end - start);
+        const Cell *source = cells + (start - col);
+        if (find_row(row, static_cast<std::int32_t>(start)) || !std::all_of(source, source + run, is_blank))
+        {
+            std::copy(source, source + run, row_span(row, static_cast<std::int32_t>(start)));
+        }
+
+        start += run;
+    }
+}
+
+void WorldGrid::fill_cells(std::int32_t top, std::int32_t left, std::int32_t rows, std::int32_t cols, const Cell &cell)
+{
+    if (rows <= 0 || cols <= 0)
+    {
+        return;
+    }
+
+    std::int64_t bottom = std::min<std::int64_t>(static_cast<std::int64_t>(top) + rows, END_COORD);
+    std::int64_t right = std::min<std::int64_t>(static_cast<std::int64_t>(left) + cols, END_COORD);
+    bool blank = is_blank(cell);
+    for (std::int64_t chunk_row = chunk_of(top); chunk_row <= chunk_of(bottom - 1); ++chunk_row)
+    {
+        std::int64_t first_row = std::max<std::int64_t>(top, chunk_row * WORLD_CHUNK_SIZE);
+        std::int64_t last_row = std::min<std::int64_t>(bottom, (chunk_row + 1) * WORLD_CHUNK_SIZE);
+        for (std::int64_t chunk_col = chunk_of(left); chunk_col <= chunk_of(right - 1); ++chunk_col)
+        {
+            std::int64_t first_col = std::max<std::int64_t>(left, chunk_col * WORLD_CHUNK_SIZE);
+            std::int64_t last_col = std::min<std::int64_t>(right, (chunk_col + 1) * WORLD_CHUNK_SIZE);
+            std::uint64_t key = chunk_key(static_cast<std::int32_t>(chunk_row), static_cast<std::int32_t>(chunk_col));
+            bool is_whole = last_row - first_row == WORLD_CHUNK_SIZE && last_col - first_col == WORLD_CHUNK_SIZE;
+            if (blank && (is_whole || !m_chunks.count(key)))
+            {
+                // a blank chunk is the same as a missing one
+                m_chunks.erase(key);
+                continue;
+            }
+
+            for (std::int64_t row = first_row; row < last_row; ++row)
+            {
+                Cell *target = row_span(static_cast<std::int32_t>(row), static_cast<std::int32_t>(first_col));
+                std::fill(target, target + (last_col - first_col), cell);
+            }
+        }
+    }
+}
+
+WorldGrid &WorldGrid::draw(std::int32_t row, std::int32_t col, const std::string &values)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_scratch.clear();
+    std::transform(values.begin(), values.end(), std::back_inserter(m_scratch),
+                   [](char value) -> Cell { return Cell{value, 0}; });
+    draw_cells(row, col, m_scratch.data(), m_scratch.size());
+    return *this;
+}
+
+WorldGrid &WorldGrid::draw(std::int32_t row, std::int32_t col, const std::vector<Letter> &letters)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_scratch.clear();
+    for (const Letter &letter : letters)
+    {
+        m_scratch.push_back(Cell{letter.value(), intern_color(letter.color())});
+    }
+
+    draw_cells(row, col, m_scratch.data(), m_scratch.size());
+    return *this;
+}
+
+WorldGrid &WorldGrid::fill(std::int32_t top, std::int32_t left, std::int32_t rows, std::int32_t cols, char value)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    fill_cells(top, left, rows, cols, Cell{value, 0});
+    return *this;
+}
+
+WorldGrid &WorldGrid::clear(std::int32_t top, std::int32_t left, std::int32_t rows, std::int32_t cols)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    fill_cells(top, left, rows, cols, Cell{' ', 0});
+    return *this;
+}
+
+WorldGrid &WorldGrid::clear()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_chunks.clear();
+    return *this;
+}
+
+Letter WorldGrid::get_letter(std::int32_t row, std::int32_t col) const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    const Cell *cell = find_row(row, col);
+    return cell ? Letter(cell->value, m_palette[cell->color]) : Letter(' ', m_palette[0]);
+}
+
+std::size_t WorldGrid::chunk_count() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_chunks.size();
+}
+
+Camera::Camera(const std::shared_ptr<WorldGrid> &world, const std::shared_ptr<TextGrid> &text_grid) : m_world(world),
+                                                                                                       m_text_grid(text_grid),
+                                                                                                       m_row(0),
+                                                                                                       m_col(0),
+                                                                                                       m_grid_palette_version(0)
+{
+}
+
+Camera &Camera::move_to(std::int32_t row, std::int32_t col)
+{
+    m_row = row;
+    m_col = col;
+    return *this;
+}
+
+Camera &Camera::move_by(std::int32_t rows, std::int32_t cols)
+{
+    m_row = static_cast<std::int32_t>(std::clamp<std::int64_t>(static_cast<std::int64_t>(m_row) + rows, MIN_COORD, END_COORD - 1));
+    m_col = static_cast<std::int32_t>(std::clamp<std::int64_t>(static_cast<std::int64_t>(m_col) + cols, MIN_COORD, END_COORD - 1));
+    return *this;
+}
+
+Camera &Camera::center_on(std::int32_t row, std::int32_t col)
+{
+    m_row = static_cast<std::int32_t>(std::max<std::int64_t>(static_cast<std::int64_t>(row) - m_text_grid->rows() / 2, MIN_COORD));
+    m_col = static_cast<std::int32_t>(std::max<std::int64_t>(static_cast<std::int64_t>(col) - m_text_grid->cols() / 2, MIN_COORD));
+    return *this;
+}
+
+std::int32_t Camera::row() const
+{
+    return m_row;
+}
+
+std::int32_t Camera::col() const
+{
+    return m_col;
+}
+
+Size Camera::rows() const
+{
+    return m_text_grid->rows();
+}
+
+Size Camera::cols() const
+{
+    return m_text_grid->cols();
+}
+
+void Camera::draw()
+{
+    const WorldGrid &world = *m_world;
+    TextGrid &text_grid = *m_text_grid;
+    std::lock_guard<std::mutex> world_guard(world.m_mutex);
+    auto guard = text_grid.lock_rows();
+    if (m_handles.size() != world.m_palette.size() || text_grid.m_palette_version != m_grid_palette_version)
+    {
+        text_grid.intern_colors(world.m_palette, m_handles);
+        m_grid_palette_version = text_grid.m_palette_version;
+    }
+
+    const Cell blank = {' ', m_handles[0]};
+    const std::int64_t end_col = static_cast<std::int64_t>(m_col) + text_grid.cols();
+    for (Size row = 0; row < text_grid.rows(); ++row)
+    {
+        std::int64_t world_row = static_cast<std::int64_t>(m_row) + row;
+        Cell *target = text_grid.row_cells(row);
+        int left = text_grid.cols();
+        int right = 0;
+        for (std::int64_t col = m_col; col < end_col;)
+        {
+            std::int64_t run = std::min<std::int64_t>(WORLD_CHUNK_SIZE - offset_in_chunk(col), end_col - col);
+            const Cell *source = nullptr;
+            if (world_row < END_COORD && col < END_COORD)
+            {
+                source = world.find_row(static_cast<std::int32_t>(world_row), static_cast<std::int32_t>(col));
+            }
+
+            int first = static_cast<int>(col - m_col);
+            for (int i = 0; i < run; ++i)
+            {
+                Cell cell = source ? Cell{source[i].value, m_handles[source[i].color]} : blank;
+                Cell &current = target[first + i];
+                if (current.value != cell.value || current.color != cell.color)
+                {
+                    current = cell;
+                    left = std::min(left, first + i);
+                    right = std::max(right, first + i + 1);
+                }
+            }
+
+            col += run;
+        }
+
+        // only the rows which changed are redrawn
+        if (right > left)
+        {
+            text_grid.damage(row, row + 1, static_cast<Index>(left), static_cast<Index>(right));
+        }
+    }
+}
+} // namespace gk
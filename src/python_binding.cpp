@@ -1,4 +1,5 @@
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 #include <pybind11/stl.h>
 
@@ -9,6 +10,31 @@ using namespace gk;
 
 namespace py = pybind11;
 
+namespace
+{
+CellLock &locked(py::object self)
+{
+    CellLock &lock = self.cast<CellLock &>();
+    if (!lock.is_locked())
+    {
+        throw std::runtime_error("The cells of the grid have been released");
+    }
+
+    return lock;
+}
+
+template <typename T>
+py::array cell_plane(py::object self, std::size_t offset)
+{
+    CellLock &lock = locked(self);
+    const char *cells = reinterpret_cast<const char *>(lock.cells());
+    return py::array(py::dtype::of<T>(),
+                     {static_cast<py::ssize_t>(lock.rows()), static_cast<py::ssize_t>(lock.cols())},
+                     {static_cast<py::ssize_t>(lock.cols() * sizeof(Cell)), static_cast<py::ssize_t>(sizeof(Cell))},
+                     cells + offset, self);
+}
+} // namespace
+
 PYBIND11_MODULE(_pyglasskey, m)
 {
     py::class_<Color>(m, "Color")
@@ -16,6 +42,8 @@ PYBIND11_MODULE(_pyglasskey, m)
         .def_property_readonly("red", &Color::red)
         .def_property_readonly("green", &Color::green)
         .def_property_readonly("blue", &Color::blue)
+        .def_property_readonly("alpha", &Color::alpha)
+        .def_property_readonly("rgba", &Color::rgba, "The packed RGBA8 value, with red in the lowest byte")
         .def("__repr__", &Color::to_string)
         .def(py::self == py::self)
         .def(py::self != py::self);
@@ -27,11 +55,12 @@ PYBIND11_MODULE(_pyglasskey, m)
             red: Red channel
             green: Green channel
             blue: Blue channel
+            alpha: Alpha channel
         
         Returns:
             a valid color object
     )gkdoc",
-          "red"_a, "green"_a, "blue"_a);
+          "red"_a, "green"_a, "blue"_a, "alpha"_a = 255);
 
     m.attr("RowHeight") = py::int_(ROW_HEIGHT);
     m.attr("ColumnWidth") = py::int_(COL_WIDTH);
@@ -142,8 +171,304 @@ PYBIND11_MODULE(_pyglasskey, m)
         .def_property_readonly("value", &Letter::value, "The ASCII character value")
         .def_property_readonly("color", &Letter::color, "The display color");
 
+    py::class_<Sprite>(m, "Sprite", R"gkdoc(
+        Class representing a pre-built block of letters which can be drawn into
+        a grid in one call. Cells holding the transparent value let the grid
+        show through. Sprites built from strings use the color mappings of the
+        grid they are drawn into, while sprites built from letters use the
+        colors of the letters.
+
+        Args:
+            lines: the rows of the sprite as strings or lists of letters
+            transparent: the value which marks a transparent cell [' ']
+    )gkdoc")
+        .def(py::init<const std::vector<std::string> &, char>(), "lines"_a, "transparent"_a = ' ')
+        .def(py::init<const std::vector<std::vector<Letter>> &, char>(), "lines"_a, "transparent"_a = ' ')
+        .def_property_readonly("rows", &Sprite::rows, "The number of rows in the sprite")
+        .def_property_readonly("cols", &Sprite::cols, "The number of columns in the sprite")
+        .def("is_opaque", &Sprite::is_opaque, R"gkdoc(
+            Whether a cell is drawn, or lets the grid show through.
+
+            Args:
+                row: the row of the cell
+                col: the column of the cell
+
+            Returns:
+                whether the cell is opaque
+        )gkdoc",
+             "row"_a, "col"_a);
+
+    py::class_<DrawBatch>(m, "DrawBatch", R"gkdoc(
+        Class which collects a sequence of drawing commands, so that they can
+        be applied to a TextGrid in one call while it is locked once. The
+        commands behave exactly as the TextGrid methods of the same name.
+    )gkdoc")
+        .def(py::init<>())
+        .def("draw", py::overload_cast<Index, Index, const std::string &>(&DrawBatch::draw), R"gkdoc(
+            Adds a command which draws a string of characters.
+
+            Args:
+                row: the row to use for writing
+                col: the column to start writing at
+                values: the values to draw
+        )gkdoc",
+             "row"_a, "col"_a, "values"_a, py::return_value_policy::reference_internal)
+        .def("draw", py::overload_cast<Index, Index, const std::vector<Letter> &>(&DrawBatch::draw), R"gkdoc(
+            Adds a command which draws a string of letters.
+
+            Args:
+                row: the row to use for writing
+                col: the column to start writing at
+                letters: the values and colors to draw
+        )gkdoc",
+             "row"_a, "col"_a, "letters"_a, py::return_value_policy::reference_internal)
+        .def("draw", py::overload_cast<const Rect &, char>(&DrawBatch::draw), R"gkdoc(
+            Adds a command which fills a rectangular area.
+
+            Args:
+                rect: the area to fill
+                value: the ASCII value to use when filling
+        )gkdoc",
+             "rect"_a, "value"_a, py::return_value_policy::reference_internal)
+        .def("clear", py::overload_cast<Index, Index, Size>(&DrawBatch::clear), R"gkdoc(
+            Adds a command which clears a region of a row.
+
+            Args:
+                row: the row to clear
+                col: the starting column
+                cols: the number of columns to clear
+        )gkdoc",
+             "row"_a, "col"_a, "cols"_a, py::return_value_policy::reference_internal)
+        .def("clear", py::overload_cast<const Rect &>(&DrawBatch::clear), R"gkdoc(
+            Adds a command which clears a rectangular region.
+
+            Args:
+                rect: the region
+        )gkdoc",
+             "rect"_a, py::return_value_policy::reference_internal)
+        .def("blit_sprite", &DrawBatch::blit_sprite, R"gkdoc(
+            Adds a command which draws a sprite. The batch keeps a reference
+            to the sprite, which must not change while the batch is in use.
+
+            Args:
+                sprite: the sprite to draw
+                row: the row of the top of the sprite
+                col: the column of the left of the sprite
+        )gkdoc",
+             "sprite"_a, "row"_a, "col"_a, py::keep_alive<1, 2>(), py::return_value_policy::reference_internal)
+        .def("reset", &DrawBatch::reset, "Removes all of the commands")
+        .def("__len__", &DrawBatch::size);
+
+    py::enum_<BackPressure>(m, "BackPressure", "What a DrawQueue does with a command added while it is full")
+        .value("Block", BackPressure::BLOCK)
+        .value("DropOldest", BackPressure::DROP_OLDEST)
+        .value("Coalesce", BackPressure::COALESCE);
+
+    py::class_<DrawQueue, std::shared_ptr<DrawQueue>>(m, "DrawQueue", R"gkdoc(
+        Class which lets any number of threads send drawing commands to a
+        TextGrid without taking its lock. The commands are applied in bulk,
+        in the order they were added, by TextGrid.apply() or by every
+        TextGrid.blit() once the queue is attached with
+        TextGrid.set_draw_queue(). The commands behave exactly as the
+        TextGrid methods of the same name.
+
+        Args:
+            capacity: the number of commands which can be pending, rounded up
+                      to a power of two
+            back_pressure: what to do with commands added while the queue is
+                           full
+    )gkdoc")
+        .def(py::init<std::size_t, BackPressure>(), "capacity"_a = 4096, "back_pressure"_a = BackPressure::BLOCK)
+        .def("draw", py::overload_cast<Index, Index, const std::string &>(&DrawQueue::draw), R"gkdoc(
+            Adds a command which draws a string of characters.
+
+            Args:
+                row: the row to use for writing
+                col: the column to start writing at
+                values: the values to draw
+        )gkdoc",
+             "row"_a, "col"_a, "values"_a, py::return_value_policy::reference_internal,
+             py::call_guard<py::gil_scoped_release>())
+        .def("draw", py::overload_cast<Index, Index, const std::vector<Letter> &>(&DrawQueue::draw), R"gkdoc(
+            Adds a command which draws a string of letters.
+
+            Args:
+                row: the row to use for writing
+                col: the column to start writing at
+                letters: the values and colors to draw
+        )gkdoc",
+             "row"_a, "col"_a, "letters"_a, py::return_value_policy::reference_internal,
+             py::call_guard<py::gil_scoped_release>())
+        .def("draw", py::overload_cast<const Rect &, char>(&DrawQueue::draw), R"gkdoc(
+            Adds a command which fills a rectangular area.
+
+            Args:
+                rect: the area to fill
+                value: the ASCII value to use when filling
+        )gkdoc",
+             "rect"_a, "value"_a, py::return_value_policy::reference_internal,
+             py::call_guard<py::gil_scoped_release>())
+        .def("clear", py::overload_cast<Index, Index, Size>(&DrawQueue::clear), R"gkdoc(
+            Adds a command which clears a region of a row.
+
+            Args:
+                row: the row to clear
+                col: the starting column
+                cols: the number of columns to clear
+        )gkdoc",
+             "row"_a, "col"_a, "cols"_a, py::return_value_policy::reference_internal,
+             py::call_guard<py::gil_scoped_release>())
+        .def("clear", py::overload_cast<const Rect &>(&DrawQueue::clear), R"gkdoc(
+            Adds a command which clears a rectangular region.
+
+            Args:
+                rect: the region
+        )gkdoc",
+             "rect"_a, py::return_value_policy::reference_internal, py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("capacity", &DrawQueue::capacity, "The number of commands which can be pending")
+        .def_property_readonly("back_pressure", &DrawQueue::back_pressure,
+                               "What is done with commands added while the queue is full")
+        .def_property_readonly("dropped", &DrawQueue::dropped, "The number of commands discarded because the queue was full")
+        .def_property_readonly("coalesced", &DrawQueue::coalesced, "The number of commands which replaced a pending command")
+        .def("__len__", &DrawQueue::size);
+
+    py::class_<CellLock>(m, "CellLock", R"gkdoc(
+        Direct access to the cells of a TextGrid, obtained with
+        TextGrid.lock_cells(). The grid stays locked until the lock is
+        released, which happens automatically at the end of a with block.
+        The values and colors arrays are views of the grid memory, not
+        copies, and must not be used once the lock is released.
+    )gkdoc")
+        .def("__enter__", [](py::object self) { return self; })
+        .def("__exit__", [](CellLock &lock, py::args) { lock.release(); })
+        .def_property_readonly("values", [](py::object self) { return cell_plane<std::uint8_t>(self, offsetof(Cell, value)); },
+                               "A writable rows x cols uint8 array of the ASCII values of the cells")
+        .def_property_readonly("colors", [](py::object self) { return cell_plane<ColorHandle>(self, offsetof(Cell, color)); },
+                               "A writable rows x cols uint16 array of the palette handles of the cells")
+        .def_property_readonly("rows", &CellLock::rows, "The number of rows in the grid")
+        .def_property_readonly("cols", &CellLock::cols, "The number of columns in the grid")
+        .def("color_handle", [](py::object self, const Color &color) { return locked(self).color_handle(color); }, R"gkdoc(
+            Returns the palette handle to use in the colors array for a color,
+            adding it to the palette of the grid if needed.
+
+            Args:
+                color: the color
+
+            Returns:
+                the handle of the color
+        )gkdoc",
+             "color"_a)
+        .def("damage", [](py::object self, Index first_row, Index last_row) { locked(self).damage(first_row, last_row); }, R"gkdoc(
+            Marks rows as modified. If this is never called, every row is
+            treated as modified when the lock is released.
+
+            Args:
+                first_row: the first modified row
+                last_row: one past the last modified row
+        )gkdoc",
+             "first_row"_a, "last_row"_a)
+        .def("release", &CellLock::release, "Marks the modified rows for redrawing and unlocks the grid")
+        .def_property_readonly("is_locked", &CellLock::is_locked, "Whether the grid is still held");
+
+    py::class_<Layer, std::shared_ptr<Layer>>(m, "Layer", R"gkdoc(
+        Class representing one of the planes of a TextGrid, created with
+        TextGrid.add_layer(). A layer starts out transparent, and the cells
+        drawn to it cover the layers beneath until they are cleared. Its
+        drawing methods behave exactly as the TextGrid methods of the same
+        name, except that clearing a cell makes it transparent.
+    )gkdoc")
+        .def("draw", py::overload_cast<Index, Index, const std::string &>(&Layer::draw), R"gkdoc(
+            Draw a string of characters at the specified row and column.
+
+            Args:
+                row: the row to use for writing
+                col: the column to start writing at
+                values: the values to draw
+        )gkdoc",
+             "row"_a, "col"_a, "values"_a, py::return_value_policy::reference_internal,
+             py::call_guard<py::gil_scoped_release>())
+        .def("draw", py::overload_cast<Index, Index, const std::vector<Letter> &>(&Layer::draw), R"gkdoc(
+            Draw a string of letters at the specified row and column.
+
+            Args:
+                row: the row to use for writing
+                col: the column to start writing at
+                letters: the values and colors to draw
+        )gkdoc",
+             "row"_a, "col"_a, "letters"_a, py::return_value_policy::reference_internal,
+             py::call_guard<py::gil_scoped_release>())
+        .def("draw", py::overload_cast<const Rect &, char>(&Layer::draw), R"gkdoc(
+            Fills a rectangular area with the specified value.
+
+            Args:
+                rect: the area to fill
+                value: the ASCII value to use when filling
+        )gkdoc",
+             "rect"_a, "value"_a, py::return_value_policy::reference_internal,
+             py::call_guard<py::gil_scoped_release>())
+        .def("clear", py::overload_cast<Index, Index, Size>(&Layer::clear), R"gkdoc(
+            Makes a region of the specified row transparent.
+
+            Args:
+                row: the row to clear
+                col: the starting column. Will be clipped appropriately
+                cols: the number of columns to clear
+        )gkdoc",
+             "row"_a, "col"_a, "cols"_a, py::return_value_policy::reference_internal,
+             py::call_guard<py::gil_scoped_release>())
+        .def("clear", py::overload_cast<const Rect &>(&Layer::clear), R"gkdoc(
+            Makes a rectangular region transparent.
+
+            Args:
+                rect: the region
+        )gkdoc",
+             "rect"_a, py::return_value_policy::reference_internal, py::call_guard<py::gil_scoped_release>())
+        .def("clear", py::overload_cast<>(&Layer::clear), "Makes the whole layer transparent",
+             py::return_value_policy::reference_internal, py::call_guard<py::gil_scoped_release>())
+        .def("recolor", &Layer::recolor, R"gkdoc(
+            Sets the color of every opaque cell in a region to the one mapped
+            to its ASCII value by the grid.
+
+            Args:
+                rect: the region to recolor
+        )gkdoc",
+             "rect"_a, py::return_value_policy::reference_internal, py::call_guard<py::gil_scoped_release>())
+        .def("scroll", &Layer::scroll, R"gkdoc(
+            Moves the contents of a rectangular region, leaving transparent
+            cells behind.
+
+            Args:
+                rect: the region to scroll
+                rows: the number of rows to move down, or up if negative
+                cols: the number of columns to move right, or left if negative
+        )gkdoc",
+             "rect"_a, "rows"_a, "cols"_a = 0, py::return_value_policy::reference_internal,
+             py::call_guard<py::gil_scoped_release>())
+        .def("blit_sprite", &Layer::blit_sprite, R"gkdoc(
+            Draws a sprite with its top-left corner at the specified row and column.
+
+            Args:
+                sprite: the sprite to draw
+                row: the row of the top of the sprite. Can be any value.
+                col: the column of the left of the sprite. Can be any value.
+        )gkdoc",
+             "sprite"_a, "row"_a, "col"_a, py::return_value_policy::reference_internal,
+             py::call_guard<py::gil_scoped_release>())
+        .def("apply", &Layer::apply, R"gkdoc(
+            Applies all of the commands in a batch to the layer.
+
+            Args:
+                batch: the commands to apply
+        )gkdoc",
+             "batch"_a, py::return_value_policy::reference_internal, py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("is_attached", &Layer::is_attached, "Whether the layer still belongs to a grid");
+
     py::class_<TextGrid, std::shared_ptr<TextGrid>>(m, "TextGrid", R"gkdoc(
-        Class representing a grid of animated ASCII text
+        Class representing a grid of animated ASCII text.
+
+        A grid can be drawn to from several threads at once. Drawing calls,
+        blit() and lock_cells() release the GIL while they wait for the grid
+        and while they copy cells, so other Python threads keep running.
     )gkdoc")
         .def("map_color", &TextGrid::map_color, R"gkdoc(
             Maps an ASCII value to have a alternate default color. This will be
@@ -153,14 +478,23 @@ PYBIND11_MODULE(_pyglasskey, m)
                 value: the ASCII value
                 color: the default color for this value
         )gkdoc",
-             "value"_a, "color"_a)
+             "value"_a, "color"_a, py::call_guard<py::gil_scoped_release>())
         .def("unmap_color", &TextGrid::unmap_color, R"gkdoc(
             Removes the color mapping for an ASCII value. 
 
             Args:
                 value: the ASCII value to unmap
             )gkdoc",
-             "value"_a)
+             "value"_a, py::call_guard<py::gil_scoped_release>())
+        .def("recolor", &TextGrid::recolor, R"gkdoc(
+            Sets the color of every cell in a region to the one currently
+            mapped to its ASCII value, e.g. after changing the mappings,
+            without drawing the text again.
+
+            Args:
+                rect: the region to recolor
+        )gkdoc",
+             "rect"_a, py::call_guard<py::gil_scoped_release>())
         .def("draw", py::overload_cast<Index, Index, const std::string &>(&TextGrid::draw), R"gkdoc(
             Draw a string of character at the specified row and column. The
             text will be truncated on the right or the left if needed.
@@ -171,7 +505,7 @@ PYBIND11_MODULE(_pyglasskey, m)
                      will be clipped appropriately
                 values: the values to draw
         )gkdoc",
-             "row"_a, "col"_a, "values"_a)
+             "row"_a, "col"_a, "values"_a, py::call_guard<py::gil_scoped_release>())
         .def("draw",
              py::overload_cast<Index, Index, const std::vector<Letter> &>(&TextGrid::draw), R"gkdoc(
             Draw a string of letters at the specified row and column. The letters
@@ -184,7 +518,7 @@ PYBIND11_MODULE(_pyglasskey, m)
                      will be clipped appropriately
                 letters: the values and colors to draw
         )gkdoc",
-             "row"_a, "col"_a, "letters"_a)
+             "row"_a, "col"_a, "letters"_a, py::call_guard<py::gil_scoped_release>())
         .def("draw", py::overload_cast<const Rect &, char>(&TextGrid::draw), R"gkdoc(
             Fills a rectangular area with the specified value
 
@@ -192,7 +526,7 @@ PYBIND11_MODULE(_pyglasskey, m)
                 rect: the areaa to fill
                 value: the ASCII value to use when filling
         )gkdoc",
-             "rect"_a, "value"_a)
+             "rect"_a, "value"_a, py::call_guard<py::gil_scoped_release>())
         .def("clear", py::overload_cast<Index, Index, Size>(&TextGrid::clear), R"gkdoc(
             Clears a region of the specified row (i.e. sets all characters to ' ').
 
@@ -201,14 +535,92 @@ PYBIND11_MODULE(_pyglasskey, m)
                 col: the starting column. Will be clipped appropriately
                 cols: the number of columns to clear.
         )gkdoc",
-             "row"_a, "col"_a, "cols"_a)
+             "row"_a, "col"_a, "cols"_a, py::call_guard<py::gil_scoped_release>())
         .def("clear", py::overload_cast<const Rect &>(&TextGrid::clear), R"gkdoc(
             Clears a rectangular region (i.e. sets all characters to ' ').
 
             Args:
                 rect: the region
         )gkdoc",
-             "rect"_a)
+             "rect"_a, py::call_guard<py::gil_scoped_release>())
+        .def("blit_sprite", &TextGrid::blit_sprite, R"gkdoc(
+            Draws a sprite with its top-left corner at the specified row and
+            column. The sprite is clipped to the grid, and its transparent
+            cells leave the grid unchanged.
+
+            Args:
+                sprite: the sprite to draw
+                row: the row of the top of the sprite. Can be any value.
+                col: the column of the left of the sprite. Can be any value.
+        )gkdoc",
+             "sprite"_a, "row"_a, "col"_a, py::call_guard<py::gil_scoped_release>())
+        .def("apply", py::overload_cast<const DrawBatch &>(&TextGrid::apply), R"gkdoc(
+            Applies all of the commands in a batch, in order, while holding the
+            lock on the grid once rather than once per command.
+
+            Args:
+                batch: the commands to apply
+        )gkdoc",
+             "batch"_a, py::call_guard<py::gil_scoped_release>())
+        .def("apply", py::overload_cast<DrawQueue &>(&TextGrid::apply), R"gkdoc(
+            Applies every command waiting in a queue, in order, while holding
+            the lock on the grid once.
+
+            Args:
+                queue: the commands to apply
+        )gkdoc",
+             "queue"_a, py::call_guard<py::gil_scoped_release>())
+        .def("set_draw_queue", &TextGrid::set_draw_queue, R"gkdoc(
+            Attaches a queue whose pending commands are applied at the start of
+            every blit(). Pass None to detach it.
+
+            Args:
+                queue: the queue to attach
+        )gkdoc",
+             "queue"_a, py::call_guard<py::gil_scoped_release>())
+        .def("scroll", &TextGrid::scroll, R"gkdoc(
+            Moves the contents of a rectangular region, e.g. to scroll a log
+            up by a line when a new one arrives. Cells moved out of the region
+            are discarded, and the cells they leave behind are cleared.
+            Scrolling whole rows vertically does not copy them, and is not
+            redrawn from scratch.
+
+            Args:
+                rect: the region to scroll
+                rows: the number of rows to move down, or up if negative
+                cols: the number of columns to move right, or left if negative
+        )gkdoc",
+             "rect"_a, "rows"_a, "cols"_a = 0, py::call_guard<py::gil_scoped_release>())
+        .def("add_layer", &TextGrid::add_layer, R"gkdoc(
+            Adds a transparent layer on top of the grid and any existing
+            layers. Each cell shows the topmost layer which is opaque there,
+            or the grid itself if none are. Only the cells drawn to since the
+            last blit are recomposited.
+
+            Returns:
+                the new layer
+        )gkdoc",
+             py::call_guard<py::gil_scoped_release>())
+        .def("remove_layer", &TextGrid::remove_layer, R"gkdoc(
+            Removes a layer from the grid. The layer can no longer be drawn to.
+
+            Args:
+                layer: a layer added to this grid
+        )gkdoc",
+             "layer"_a, py::call_guard<py::gil_scoped_release>())
+        .def("lock_cells", [](TextGrid &text_grid) {
+            // waiting for the grid must not stop other threads from running Python
+            py::gil_scoped_release release;
+            return std::make_unique<CellLock>(text_grid);
+        }, py::keep_alive<0, 1>(), R"gkdoc(
+            Locks the grid and gives direct access to its cells, e.g.
+
+                with text_grid.lock_cells() as cells:
+                    cells.values[:] = frame
+
+            Returns:
+                a CellLock, which releases the grid at the end of a with block
+        )gkdoc")
         .def("get_letter", &TextGrid::get_letter, R"gkdoc(
             Get the ASCII value and color at the specified index.
 
@@ -220,17 +632,42 @@ PYBIND11_MODULE(_pyglasskey, m)
                 the letter at this index
         )gkdoc",
              "row"_a, "col"_a)
-        .def("get_row", &TextGrid::get_row, R"gkdoc(
+        .def("get_row", [](const TextGrid &text_grid, Index row) {
+            Row view = text_grid.get_row(row);
+            std::vector<Letter> letters;
+            letters.reserve(view.size());
+            for (Size col = 0; col < view.size(); ++col)
+            {
+                letters.push_back(view[col]);
+            }
+
+            return letters;
+        }, R"gkdoc(
             Get the desired Row.
 
             Args:
                 row: must be a valid row index in the range [0, rows]
             
             Returns:
-                a reference to the row
+                a list of the letters in the row
         )gkdoc",
              "row"_a)
-        .def("blit", &TextGrid::blit, "Requests that the TextGrid be redrawn to the screen")
+        .def("blit", &TextGrid::blit, "Requests that the TextGrid be redrawn to the screen",
+             py::call_guard<py::gil_scoped_release>())
+        .def("start_recording", &TextGrid::start_recording, R"gkdoc(
+            Starts recording every blitted frame into a compact binary file,
+            replacing any recording already in progress. The file is written
+            on a background thread.
+
+            Args:
+                path: the path of the file to write
+                keyframe_interval: the number of frames between keyframes
+        )gkdoc",
+             "path"_a, "keyframe_interval"_a = 300, py::call_guard<py::gil_scoped_release>())
+        .def("stop_recording", &TextGrid::stop_recording,
+             "Stops recording, waiting until all recorded frames have been written. Raises RuntimeError if the recording could not be written",
+             py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("is_recording", &TextGrid::is_recording, "Whether blitted frames are being recorded")
         .def("__repr__", &TextGrid::to_string)
         .def_property_readonly("rows", &TextGrid::rows, "The number of rows in the grid")
         .def_property_readonly("cols", &TextGrid::cols, "The number of columns in the grid")
@@ -240,6 +677,267 @@ PYBIND11_MODULE(_pyglasskey, m)
             This will be shown in the title bar of its window.
         )gkdoc");
 
+    py::class_<WorldGrid, std::shared_ptr<WorldGrid>>(m, "WorldGrid", R"gkdoc(
+        Class representing a world of cells far larger than a TextGrid,
+        addressed by 32-bit rows and columns which may be negative. Cells are
+        stored in chunks which are only allocated once something other than a
+        blank is drawn in them. The world is shown through a Camera.
+
+        Args:
+            default_color: the color of blank cells, and of strings drawn
+                           without colors
+    )gkdoc")
+        .def(py::init<const Color &>(), "default_color"_a = Colors::White)
+        .def("draw", py::overload_cast<std::int32_t, std::int32_t, const std::string &>(&WorldGrid::draw), R"gkdoc(
+            Draw a string of characters in the default color.
+
+            Args:
+                row: the row of the first character
+                col: the column of the first character
+                values: the characters to draw
+        )gkdoc",
+             "row"_a, "col"_a, "values"_a, py::return_value_policy::reference_internal,
+             py::call_guard<py::gil_scoped_release>())
+        .def("draw", py::overload_cast<std::int32_t, std::int32_t, const std::vector<Letter> &>(&WorldGrid::draw), R"gkdoc(
+            Draw a string of letters.
+
+            Args:
+                row: the row of the first letter
+                col: the column of the first letter
+                letters: the values and colors to draw
+        )gkdoc",
+             "row"_a, "col"_a, "letters"_a, py::return_value_policy::reference_internal,
+             py::call_guard<py::gil_scoped_release>())
+        .def("fill", &WorldGrid::fill, R"gkdoc(
+            Fills a region with the specified value in the default color.
+
+            Args:
+                top: the first row of the region
+                left: the first column of the region
+                rows: the number of rows in the region
+                cols: the number of columns in the region
+                value: the value to fill with
+        )gkdoc",
+             "top"_a, "left"_a, "rows"_a, "cols"_a, "value"_a, py::return_value_policy::reference_internal,
+             py::call_guard<py::gil_scoped_release>())
+        .def("clear", py::overload_cast<std::int32_t, std::int32_t, std::int32_t, std::int32_t>(&WorldGrid::clear), R"gkdoc(
+            Clears a region, freeing any chunks which it covers entirely.
+
+            Args:
+                top: the first row of the region
+                left: the first column of the region
+                rows: the number of rows in the region
+                cols: the number of columns in the region
+        )gkdoc",
+             "top"_a, "left"_a, "rows"_a, "cols"_a, py::return_value_policy::reference_internal,
+             py::call_guard<py::gil_scoped_release>())
+        .def("clear", py::overload_cast<>(&WorldGrid::clear), "Clears the whole world, freeing every chunk",
+             py::return_value_policy::reference_internal)
+        .def("get_letter", &WorldGrid::get_letter, "Get the ASCII value and color at the specified cell",
+             "row"_a, "col"_a)
+        .def_property_readonly("chunk_count", &WorldGrid::chunk_count, "The number of chunks which have been allocated");
+
+    py::class_<Camera>(m, "Camera", R"gkdoc(
+        Class which shows the part of a WorldGrid under a window the size of a
+        TextGrid. Each call to draw() copies only the visible cells, and only
+        the rows which changed are redrawn.
+
+        Args:
+            world: the world to show
+            text_grid: the grid to show it in
+    )gkdoc")
+        .def(py::init<const std::shared_ptr<WorldGrid> &, const std::shared_ptr<TextGrid> &>(), "world"_a, "text_grid"_a)
+        .def("move_to", &Camera::move_to, "Moves the top-left corner of the camera to a cell of the world",
+             "row"_a, "col"_a, py::return_value_policy::reference_internal)
+        .def("move_by", &Camera::move_by, "Moves the camera by an offset", "rows"_a, "cols"_a,
+             py::return_value_policy::reference_internal)
+        .def("center_on", &Camera::center_on, "Moves the camera so that a cell of the world is in the middle of the grid",
+             "row"_a, "col"_a, py::return_value_policy::reference_internal)
+        .def_property_readonly("row", &Camera::row, "The row of the world shown in the first row of the grid")
+        .def_property_readonly("col", &Camera::col, "The column of the world shown in the first column of the grid")
+        .def_property_readonly("rows", &Camera::rows, "The number of rows of the world which are shown")
+        .def_property_readonly("cols", &Camera::cols, "The number of columns of the world which are shown")
+        .def("draw", &Camera::draw, "Copies the visible part of the world into the grid. The grid is not blitted.",
+             py::call_guard<py::gil_scoped_release>());
+
+    py::class_<TileMapWriter>(m, "TileMapWriter", R"gkdoc(
+        Class which converts a map into the tiled file format read by
+        MapStreamer. The map is written one row at a time from top to bottom,
+        and only one band of tiles is held in memory.
+
+        Args:
+            path: the path of the file to write
+            rows: the number of rows in the map
+            cols: the number of columns in the map
+            default_color: the color of blank cells, and of rows written
+                           without colors
+    )gkdoc")
+        .def(py::init<const std::string &, std::uint32_t, std::uint32_t, const Color &>(), "path"_a, "rows"_a, "cols"_a,
+             "default_color"_a = Colors::White)
+        .def("write_row", py::overload_cast<const std::string &>(&TileMapWriter::write_row), R"gkdoc(
+            Writes the next row of the map in the default color.
+
+            Args:
+                values: the characters of the row
+        )gkdoc",
+             "values"_a, py::call_guard<py::gil_scoped_release>())
+        .def("write_row", py::overload_cast<const std::vector<Letter> &>(&TileMapWriter::write_row), R"gkdoc(
+            Writes the next row of the map.
+
+            Args:
+                letters: the letters of the row
+        )gkdoc",
+             "letters"_a, py::call_guard<py::gil_scoped_release>())
+        .def("close", &TileMapWriter::close, "Fills any rows not yet written with blanks and finishes the file",
+             py::call_guard<py::gil_scoped_release>());
+
+    py::class_<MapStreamer>(m, "MapStreamer", R"gkdoc(
+        Class which streams a tile map written by TileMapWriter into a
+        WorldGrid. The file is memory-mapped, and tiles are loaded on a
+        background thread as the view moves, so only the tiles near the view
+        take up memory.
+
+        Args:
+            path: the path of the map
+            world: the world to load tiles into
+            max_tiles: the number of tiles to keep loaded. Tiles under the
+                       view are kept even beyond this number.
+    )gkdoc")
+        .def(py::init<const std::string &, const std::shared_ptr<WorldGrid> &, std::size_t>(), "path"_a, "world"_a,
+             "max_tiles"_a = 1024)
+        .def_property_readonly("rows", &MapStreamer::rows, "The number of rows in the map")
+        .def_property_readonly("cols", &MapStreamer::cols, "The number of columns in the map")
+        .def("update", py::overload_cast<std::int32_t, std::int32_t, std::int32_t, std::int32_t>(&MapStreamer::update), R"gkdoc(
+            Moves the view, requesting the tiles under it and prefetching ahead
+            of it in the direction it moved. Never blocks on loading.
+
+            Args:
+                top: the first row of the view
+                left: the first column of the view
+                rows: the number of rows in the view
+                cols: the number of columns in the view
+        )gkdoc",
+             "top"_a, "left"_a, "rows"_a, "cols"_a)
+        .def("update", py::overload_cast<const Camera &>(&MapStreamer::update),
+             "Moves the view to the region shown by a camera", "camera"_a)
+        .def("wait", &MapStreamer::wait, "Blocks until every requested tile has been loaded",
+             py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("loaded_tiles", &MapStreamer::loaded_tiles, "The number of tiles loaded into the world");
+
+    py::class_<ReplayPlayer>(m, "ReplayPlayer", R"gkdoc(
+        Class which plays back a recording made with TextGrid.start_recording().
+        The file is memory-mapped, so opening it is immediate and only the
+        current frame is held in memory.
+
+        Args:
+            path: the path of the recording
+    )gkdoc")
+        .def(py::init<const std::string &>(), "path"_a)
+        .def_property_readonly("rows", &ReplayPlayer::rows, "The number of rows in the recorded grid")
+        .def_property_readonly("cols", &ReplayPlayer::cols, "The number of columns in the recorded grid")
+        .def_property_readonly("frames", &ReplayPlayer::frames, "The number of frames in the recording")
+        .def_property_readonly("keyframes", &ReplayPlayer::keyframes, "The number of keyframes in the recording")
+        .def_property_readonly("frame", &ReplayPlayer::frame, "The number of the current frame")
+        .def_property_readonly("time", &ReplayPlayer::time, "The position of playback, in seconds from the first frame")
+        .def_property_readonly("duration", &ReplayPlayer::duration, "The time of the last frame, in seconds from the first frame")
+        .def_property_readonly("is_finished", &ReplayPlayer::is_finished, "Whether the last frame has been reached")
+        .def("seek_keyframe", &ReplayPlayer::seek_keyframe, R"gkdoc(
+            Moves to a keyframe.
+
+            Args:
+                keyframe: the index of the keyframe, in the range [0, keyframes)
+        )gkdoc",
+             "keyframe"_a, py::call_guard<py::gil_scoped_release>())
+        .def("seek", &ReplayPlayer::seek, R"gkdoc(
+            Moves to a frame.
+
+            Args:
+                frame: the frame number, in the range [0, frames)
+        )gkdoc",
+             "frame"_a, py::call_guard<py::gil_scoped_release>())
+        .def("step", &ReplayPlayer::step, R"gkdoc(
+            Moves to the next frame.
+
+            Returns:
+                whether there was another frame
+        )gkdoc", py::call_guard<py::gil_scoped_release>())
+        .def("advance", &ReplayPlayer::advance, R"gkdoc(
+            Advances playback by an amount of recorded time, moving past every
+            frame recorded in that interval.
+
+            Args:
+                seconds: the time to advance by
+
+            Returns:
+                the number of frames moved past
+        )gkdoc",
+             "seconds"_a, py::call_guard<py::gil_scoped_release>())
+        .def("show", &ReplayPlayer::show, R"gkdoc(
+            Draws the current frame into a grid, without blitting it.
+
+            Args:
+                text_grid: the grid to draw into
+        )gkdoc",
+             "text_grid"_a, py::call_guard<py::gil_scoped_release>())
+        .def("play", &ReplayPlayer::play, R"gkdoc(
+            Blocking call which plays the rest of the recording into a grid,
+            blitting one frame of the grid per call to next_frame().
+
+            Args:
+                text_grid: the grid to draw into
+                frames_per_second: the rate at which the grid is blitted
+                speed: the rate of playback relative to the recording
+        )gkdoc",
+             "text_grid"_a, "frames_per_second"_a = 30.0f, "speed"_a = 1.0f, py::call_guard<py::gil_scoped_release>());
+
+    py::enum_<BackendType>(m, "BackendType", "The systems which can be used to display grids")
+        .value("OpenGL", BackendType::OPENGL)
+        .value("Headless", BackendType::HEADLESS)
+        .value("Terminal", BackendType::TERMINAL);
+
+    m.def("set_backend", &set_backend, R"gkdoc(
+        Selects the system used to display grids. Must be called before init()
+        or start(), and has no effect afterwards.
+
+        Args:
+            backend: the backend to use
+    )gkdoc",
+          "backend"_a);
+    m.def("backend", &backend, "The system used to display grids");
+
+    py::class_<Image>(m, "Image", "An image stored as RGBA8 pixels, in rows from top to bottom")
+        .def_readonly("width", &Image::width, "The width in pixels")
+        .def_readonly("height", &Image::height, "The height in pixels")
+        .def("to_bytes", [](const Image &image) {
+            return py::bytes(reinterpret_cast<const char *>(image.pixels.data()), image.pixels.size() * sizeof(std::uint32_t));
+        }, "The pixels as RGBA bytes");
+
+    m.def("read_pixels", [](const std::shared_ptr<TextGrid> &text_grid) -> py::object {
+        Image image;
+        bool is_supported;
+        {
+            py::gil_scoped_release release;
+            is_supported = read_pixels(text_grid, image);
+        }
+
+        if (!is_supported)
+        {
+            return py::none();
+        }
+
+        return py::cast(std::move(image));
+    }, R"gkdoc(
+        Reads back the most recently blitted frame of a grid as pixels. Only
+        supported by the Headless backend.
+
+        Args:
+            text_grid: the grid to read
+
+        Returns:
+            an Image, or None if the backend does not support reading pixels
+    )gkdoc",
+          "text_grid"_a);
+
     m.def("init", &init, "Manually initialize the library", R"gkdoc(
         Initializes the underlying OpenGL context. Pass any OS-specific parameters via
         this method. Will be called by default the first time start() is called otherwise.
@@ -248,8 +946,8 @@ PYBIND11_MODULE(_pyglasskey, m)
             args: the vector of OpenGL command line arguments
     )gkdoc",
           "args"_a = std::vector<std::string>());
-    m.def("start", &start, "Start the GL event loop");
-    m.def("stop", &stop, "Stop the GL event loop");
+    m.def("start", &start, "Start the GL event loop", py::call_guard<py::gil_scoped_release>());
+    m.def("stop", &stop, "Stop the GL event loop", py::call_guard<py::gil_scoped_release>());
     m.def("create_grid", &create_grid, "rows"_a, "cols"_a, "title"_a = "Title", "default_color"_a = Colors::White);
     m.def("destroy_grid", &destroy_grid, "text_grid"_a, R"gkdoc(
         Destroys a text grid object.
@@ -257,7 +955,7 @@ PYBIND11_MODULE(_pyglasskey, m)
         Args:
             text_grid: the grid to destroy
     )gkdoc");
-    m.def("is_pressed", &is_pressed, R"gkdoc(
+    m.def("is_pressed", py::overload_cast<Key>(&is_pressed), R"gkdoc(
         Whether a key is pressed.
 
         Args:
@@ -266,11 +964,122 @@ PYBIND11_MODULE(_pyglasskey, m)
         Returns:
             whether the key is pressed
     )gkdoc", "key"_a);
+    m.def("is_pressed", py::overload_cast<int, bool>(&is_pressed), R"gkdoc(
+        Whether any key is pressed, by the code it is reported with in KeyEvent.
+
+        Args:
+            code: the character code, e.g. ord("a"), or the backend's code for a special key
+            is_special: whether the code is for a special key
+
+        Returns:
+            whether the key is pressed
+    )gkdoc", "code"_a, "is_special"_a = false);
+
+    py::class_<KeyEvent>(m, "KeyEvent", "A key being pressed or released")
+        .def_readonly("time", &KeyEvent::time,
+                      "When the backend received the event, in seconds on the clock of time.monotonic()")
+        .def_readonly("code", &KeyEvent::code, "The character code, or the backend's code for a special key")
+        .def_readonly("is_special", &KeyEvent::is_special, "Whether the code is for a special key")
+        .def_readonly("is_pressed", &KeyEvent::is_pressed, "Whether the key was pressed, rather than released")
+        .def_property_readonly(
+            "key", [](const KeyEvent &event) -> py::object {
+                return event.has_key ? py::cast(event.key) : py::none();
+            },
+            "The Key, or None if the key is not one of its values")
+        .def("__repr__", [](const KeyEvent &event) {
+            return "KeyEvent(code=" + std::to_string(event.code) + ", is_special=" + (event.is_special ? "True" : "False") +
+                   ", is_pressed=" + (event.is_pressed ? "True" : "False") + ")";
+        });
+
+    m.def("drain_key_events", py::overload_cast<>(&drain_key_events), R"gkdoc(
+        Removes the key events received since the last drain, oldest first.
+        Events are kept even when they arrive between two polls of
+        is_pressed(), so quick taps are never missed.
+
+        Returns:
+            a list of KeyEvent
+    )gkdoc");
+    m.def("dropped_key_events", &dropped_key_events, "The number of key events dropped because the queue was full");
     m.def("next_frame", &next_frame, R"gkdoc(
         Blocking call that waits for the next frame of animation.
 
         Args:
             frames_per_second: the target frame rate
     )gkdoc",
-          "frames_per_second"_a = 30.0);
+          "frames_per_second"_a = 30.0, py::call_guard<py::gil_scoped_release>());
+
+    py::class_<FramePacerStats>(m, "FramePacerStats", "Timing statistics gathered by a FramePacer")
+        .def_readonly("frames", &FramePacerStats::frames, "The number of frames which have been paced")
+        .def_readonly("missed_deadlines", &FramePacerStats::missed_deadlines,
+                      "The number of frames which were already past their deadline when waited for")
+        .def_readonly("mean_jitter", &FramePacerStats::mean_jitter,
+                      "The mean absolute difference between frame intervals and the target period, in seconds")
+        .def_readonly("max_jitter", &FramePacerStats::max_jitter,
+                      "The largest absolute difference between a frame interval and the target period, in seconds")
+        .def_readonly("effective_fps", &FramePacerStats::effective_fps, "The frame rate actually achieved");
+
+    py::class_<FramePacer>(m, "FramePacer", R"gkdoc(
+        Class which paces a loop to a target frame rate using absolute deadlines.
+
+        Args:
+            frames_per_second: the target frame rate
+    )gkdoc")
+        .def(py::init<float>(), "frames_per_second"_a = 30.0f)
+        .def("wait", &FramePacer::wait, "Blocks until the deadline for the next frame",
+             py::call_guard<py::gil_scoped_release>())
+        .def("reset", &FramePacer::reset, "Restarts the schedule and clears the statistics")
+        .def_property("rate", &FramePacer::rate, &FramePacer::set_rate, "The target frame rate")
+        .def_property_readonly("stats", &FramePacer::stats, "The timing statistics gathered so far");
+
+    m.def("frame_pacer", &frame_pacer, py::return_value_policy::reference,
+          "The FramePacer used by next_frame() on the calling thread");
+
+    py::class_<PhaseStats>(m, "PhaseStats", "The durations of one phase of drawing, in seconds")
+        .def_readonly("count", &PhaseStats::count, "The number of times the phase was timed")
+        .def_readonly("total", &PhaseStats::total, "The total time spent in the phase")
+        .def_readonly("max", &PhaseStats::max, "The longest single occurrence of the phase")
+        .def_readonly("last", &PhaseStats::last, "The most recent occurrence of the phase");
+
+    py::class_<RenderStats>(m, "RenderStats", "Performance counters shared by all grids and the render thread")
+        .def_readonly("frames_blitted", &RenderStats::frames_blitted, "The number of frames passed to TextGrid.blit()")
+        .def_readonly("frames_presented", &RenderStats::frames_presented,
+                      "The number of blitted frames picked up and drawn by a backend")
+        .def_readonly("frames_dropped", &RenderStats::frames_dropped,
+                      "The number of blitted frames replaced by a newer one before they were drawn")
+        .def_readonly("frames_not_recorded", &RenderStats::frames_not_recorded,
+                      "The number of blitted frames left out of a recording because it was being written too slowly")
+        .def_readonly("cells_drawn", &RenderStats::cells_drawn,
+                      "The number of cells in the regions modified by drawing calls")
+        .def_readonly("lock_wait", &RenderStats::lock_wait,
+                      "Time spent by drawing calls waiting for a grid which another thread held")
+        .def_readonly("blit", &RenderStats::blit, "Time spent in TextGrid.blit() publishing frames")
+        .def_readonly("draw_rows", &RenderStats::draw_rows,
+                      "Time the backends spent drawing each frame, including presenting it")
+        .def_readonly("present", &RenderStats::present, "Time spent handing drawn frames to the display")
+        .def_readonly("update", &RenderStats::update,
+                      "Time the render thread spent in each pass over the grids and events")
+        .def_readonly("idle", &RenderStats::idle, "Time the render thread spent waiting for work")
+        .def_readonly("oversleep", &RenderStats::oversleep,
+                      "How late FramePacer.wait() and next_frame() returned after their deadlines");
+
+    m.def("render_stats", &render_stats, R"gkdoc(
+        The performance counters gathered since the program started or the
+        last call to reset_render_stats().
+
+        Returns:
+            a RenderStats snapshot
+    )gkdoc");
+
+    m.def("reset_render_stats", &reset_render_stats, "Clears the performance counters");
+
+    m.def("set_timing_enabled", &set_timing_enabled, R"gkdoc(
+        Turns the timing of the phases in RenderStats on or off. Timing is off
+        by default.
+
+        Args:
+            enabled: whether phases should be timed
+    )gkdoc",
+          "enabled"_a);
+
+    m.def("is_timing_enabled", &is_timing_enabled, "Whether the phases in RenderStats are being timed");
 }
\ No newline at end of file
@@ -0,0 +1,21 @@
+#ifndef _GK_TEST_CHECK_H_
+#define _GK_TEST_CHECK_H_
+
+#include <cstdlib>
+#include <iostream>
+
+/** Ends the test with a failure, reporting where, if the condition is false.
+ *  May be used from any thread, and while the render thread is running.
+ */
+#define CHECK(condition)                                                    \
+    do                                                                      \
+    {                                                                       \
+        if (!(condition))                                                   \
+        {                                                                   \
+            std::cerr << __FILE__ << ":" << __LINE__                        \
+                      << ": CHECK(" #condition ") failed" << std::endl;     \
+            std::_Exit(EXIT_FAILURE);                                       \
+        }                                                                   \
+    } while (false)
+
+#endif
@@ -0,0 +1,142 @@
+#include "glasskey/glasskey.h"
+#include "check.h"
+
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <thread>
+
+using namespace gk;
+
+namespace
+{
+const int PRODUCERS = 4;
+const int COMMANDS = 20000;
+const Size COLS = 8;
+
+std::string row_text(const std::shared_ptr<TextGrid> &grid, Index row)
+{
+    std::string text;
+    for (Index col = 0; col < static_cast<Index>(COLS); ++col)
+    {
+        text += grid->get_letter(row, col).value();
+    }
+
+    return text;
+}
+
+/** Each producer counts up in its own row while the test thread applies the
+ *  queue, as a game would between frames.
+ */
+void stress(BackPressure back_pressure)
+{
+    auto grid = create_grid(PRODUCERS, COLS, "draw_queue_test");
+    DrawQueue queue(64, back_pressure);
+    std::atomic<int> finished(0);
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < PRODUCERS; ++producer)
+    {
+        producers.emplace_back([&, producer] {
+            char text[16];
+            for (int i = 1; i <= COMMANDS; ++i)
+            {
+                std::snprintf(text, sizeof(text), "%08d", i);
+                if (i % 2)
+                {
+                    queue.draw(producer, 0, text);
+                }
+                else
+                {
+                    std::vector<Letter> letters;
+                    for (Size col = 0; col < COLS; ++col)
+                    {
+                        letters.emplace_back(text[col], Colors::Red);
+                    }
+
+                    queue.draw(producer, 0, letters);
+                }
+            }
+
+            ++finished;
+        });
+    }
+
+    while (finished < PRODUCERS)
+    {
+        grid->apply(queue);
+    }
+
+    for (auto &producer : producers)
+    {
+        producer.join();
+    }
+
+    grid->apply(queue);
+    CHECK(queue.size() == 0);
+    CHECK(queue.dropped() < static_cast<std::uint64_t>(PRODUCERS) * COMMANDS);
+    for (int producer = 0; producer < PRODUCERS; ++producer)
+    {
+        std::string text = row_text(grid, producer);
+        if (back_pressure == BackPressure::BLOCK)
+        {
+            // nothing is lost, so every row ends with its last value
+            CHECK(text == "00020000");
+        }
+        else
+        {
+            // a row may never have been applied if all of its commands were
+            // discarded, but a command is either applied whole or not at all
+            bool is_blank = text == std::string(COLS, ' ');
+            bool is_value = true;
+            for (char value : text)
+            {
+                is_value = is_value && std::isdigit(static_cast<unsigned char>(value));
+            }
+
+            CHECK(is_blank || is_value);
+        }
+    }
+
+    if (back_pressure == BackPressure::BLOCK)
+    {
+        CHECK(queue.dropped() == 0);
+        CHECK(queue.coalesced() == 0);
+    }
+}
+
+void test_coalesce_same_extent()
+{
+    auto grid = create_grid(2, 10, "draw_queue_test");
+    DrawQueue queue(2, BackPressure::COALESCE);
+    queue.draw(0, 0, "AAAAA").draw(1, 0, "x").draw(0, 0, "CCCCC");
+    grid->apply(queue);
+    CHECK(queue.coalesced() == 1);
+    CHECK(queue.dropped() == 0);
+    CHECK(grid->get_letter(0, 0).value() == 'C');
+    CHECK(grid->get_letter(1, 0).value() == 'x');
+}
+
+void test_coalesce_past_overlap()
+{
+    // the clear was added after the first draw and covers it, so the second
+    // draw must not take the first one's place and be cleared as well
+    auto grid = create_grid(1, 10, "draw_queue_test");
+    DrawQueue queue(2, BackPressure::COALESCE);
+    queue.draw(0, 0, "AAAAA").clear(Rect(0, 0, 10, 1)).draw(0, 0, "BBBBB");
+    grid->apply(queue);
+    CHECK(queue.coalesced() == 0);
+    CHECK(queue.dropped() == 1);
+    CHECK(grid->get_letter(0, 0).value() == 'B');
+}
+} // namespace
+
+int main()
+{
+    set_backend(BackendType::HEADLESS);
+    stress(BackPressure::BLOCK);
+    stress(BackPressure::DROP_OLDEST);
+    stress(BackPressure::COALESCE);
+    test_coalesce_same_extent();
+    test_coalesce_past_overlap();
+    return 0;
+}
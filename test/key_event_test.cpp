@@ -0,0 +1,124 @@
+#include "glasskey/backend.h"
+#include "check.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+using namespace gk;
+
+namespace
+{
+const int CONSUMERS = 3;
+const int EVENTS = 100000;
+
+// codes beyond those tracked by is_pressed(), so that each event is unique
+const int FIRST_CODE = 1000;
+
+KeyEvent key_event(int code, bool is_pressed)
+{
+    KeyEvent event{};
+    event.code = code;
+    event.is_pressed = is_pressed;
+    return event;
+}
+
+void test_overflow()
+{
+    // the test thread stands in for the render thread, which is not started
+    const int extra = 10;
+    for (int i = 0; i < static_cast<int>(KEY_EVENT_CAPACITY) + extra; ++i)
+    {
+        add_key_event(key_event(FIRST_CODE + i, true));
+    }
+
+    CHECK(dropped_key_events() == static_cast<std::uint64_t>(extra));
+
+    // the oldest events are kept and the newest dropped
+    std::vector<KeyEvent> events = drain_key_events();
+    CHECK(events.size() == KEY_EVENT_CAPACITY);
+    for (std::size_t i = 0; i < events.size(); ++i)
+    {
+        CHECK(events[i].code == FIRST_CODE + static_cast<int>(i));
+    }
+
+    CHECK(drain_key_events().empty());
+
+    // a dropped event still updates the pressed state
+    for (std::size_t i = 0; i < KEY_EVENT_CAPACITY; ++i)
+    {
+        add_key_event(key_event(FIRST_CODE, true));
+    }
+
+    KeyEvent space = key_event(' ', true);
+    space.has_key = true;
+    space.key = Key::SPACE;
+    add_key_event(space);
+    CHECK(dropped_key_events() == static_cast<std::uint64_t>(extra) + 1);
+    CHECK(is_pressed(Key::SPACE));
+    CHECK(is_pressed(' '));
+    CHECK(drain_key_events().size() == KEY_EVENT_CAPACITY);
+
+    space.is_pressed = false;
+    add_key_event(space);
+    CHECK(!is_pressed(Key::SPACE));
+    CHECK(!is_pressed(' '));
+    CHECK(drain_key_events().size() == 1);
+}
+
+void test_concurrent_drain()
+{
+    std::uint64_t dropped = dropped_key_events();
+    std::atomic<bool> is_done(false);
+    std::vector<std::vector<KeyEvent>> received(CONSUMERS);
+    std::vector<std::thread> consumers;
+    for (int consumer = 0; consumer < CONSUMERS; ++consumer)
+    {
+        consumers.emplace_back([&, consumer] {
+            while (!is_done)
+            {
+                drain_key_events(received[consumer]);
+            }
+
+            drain_key_events(received[consumer]);
+        });
+    }
+
+    for (int i = 0; i < EVENTS; ++i)
+    {
+        add_key_event(key_event(FIRST_CODE + i, i % 2 == 0));
+        if (i % 64 == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    is_done = true;
+    for (auto &consumer : consumers)
+    {
+        consumer.join();
+    }
+
+    // each event reaches exactly one consumer, and in order
+    std::vector<int> codes;
+    for (const auto &events : received)
+    {
+        for (std::size_t i = 0; i < events.size(); ++i)
+        {
+            CHECK(i == 0 || events[i].code > events[i - 1].code);
+            codes.push_back(events[i].code);
+        }
+    }
+
+    std::sort(codes.begin(), codes.end());
+    CHECK(std::adjacent_find(codes.begin(), codes.end()) == codes.end());
+    CHECK(codes.size() + (dropped_key_events() - dropped) == static_cast<std::size_t>(EVENTS));
+}
+} // namespace
+
+int main()
+{
+    test_overflow();
+    test_concurrent_drain();
+    return 0;
+}
@@ -0,0 +1,182 @@
+#include "glasskey/glasskey.h"
+#include "glasskey/recording.h"
+#include "check.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+using namespace gk;
+
+namespace
+{
+const Size ROWS = 12;
+const Size COLS = 30;
+const int FRAMES = 100;
+const std::uint32_t KEYFRAME_INTERVAL = 7;
+const char *PATH = "recording_test.gkrec";
+const char *CORRUPT_PATH = "recording_test_corrupt.gkrec";
+
+using Snapshot = std::vector<Letter>;
+
+Snapshot snapshot(const TextGrid &grid)
+{
+    Snapshot letters;
+    for (Size row = 0; row < ROWS; ++row)
+    {
+        for (Size col = 0; col < COLS; ++col)
+        {
+            letters.push_back(grid.get_letter(row, col));
+        }
+    }
+
+    return letters;
+}
+
+bool is_same(const Snapshot &lhs, const Snapshot &rhs)
+{
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](const Letter &left, const Letter &right) {
+        return left.value() == right.value() && left.color() == right.color();
+    });
+}
+
+/** Draws something different into each frame: text, runs of new colors,
+ *  fills, clears and scrolls of whole rows and of regions.
+ */
+void draw_frame(TextGrid &grid, int frame)
+{
+    grid.draw(frame % ROWS, frame % 20, "frame " + std::to_string(frame));
+    std::vector<Letter> letters;
+    for (int i = 0; i < 5; ++i)
+    {
+        letters.emplace_back('a' + (frame + i) % 26, Color::from_bytes(frame * 2, i * 40, 255 - frame, 255));
+    }
+
+    grid.draw((frame * 5) % ROWS, (frame * 3) % COLS, letters);
+    if (frame % 5 == 0)
+    {
+        grid.draw(Rect(frame % 10, 2, 4, 3), '#');
+    }
+
+    if (frame % 11 == 0)
+    {
+        grid.clear(Rect(0, 0, COLS, 2));
+    }
+
+    if (frame % 3 == 0)
+    {
+        grid.scroll(Rect(0, 0, COLS, ROWS), -1);
+    }
+    else if (frame % 8 == 0)
+    {
+        grid.scroll(Rect(5, 4, 10, 6), 2, 1);
+    }
+}
+
+/** Copies the recording with one value of its index replaced, and returns
+ *  whether the player refuses to open the copy.
+ *
+ *  \param field the offset of the value from the start of the index
+ *  \param value the value to write there
+ */
+bool is_rejected(std::size_t field, std::uint32_t value)
+{
+    std::ifstream input(PATH, std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    std::uint64_t index = recording::get<std::uint64_t>(data.data() + data.size() - recording::TRAILER_SIZE) + 1;
+    std::vector<char> bytes;
+    recording::put<std::uint32_t>(bytes, value);
+    std::copy(bytes.begin(), bytes.end(), data.begin() + index + field);
+    {
+        std::ofstream output(CORRUPT_PATH, std::ios::binary | std::ios::trunc);
+        output.write(data.data(), data.size());
+    }
+
+    bool is_rejected = false;
+    try
+    {
+        ReplayPlayer player(CORRUPT_PATH);
+    }
+    catch (const std::runtime_error &)
+    {
+        is_rejected = true;
+    }
+
+    std::remove(CORRUPT_PATH);
+    return is_rejected;
+}
+
+void compare(ReplayPlayer &player, const Snapshot &expected)
+{
+    auto grid = create_grid(ROWS, COLS, "recording_test");
+    player.show(*grid);
+    CHECK(is_same(snapshot(*grid), expected));
+    destroy_grid(grid);
+}
+} // namespace
+
+int main()
+{
+    set_backend(BackendType::HEADLESS);
+    std::vector<Snapshot> expected;
+    {
+        auto grid = create_grid(ROWS, COLS, "recording_test");
+        grid->map_color('#', Colors::Green);
+        grid->start_recording(PATH, KEYFRAME_INTERVAL);
+        CHECK(grid->is_recording());
+
+        // fewer frames than the writer can fall behind by, so none are skipped
+        for (int frame = 0; frame < FRAMES; ++frame)
+        {
+            draw_frame(*grid, frame);
+            grid->blit();
+            expected.push_back(snapshot(*grid));
+        }
+
+        grid->stop_recording();
+        CHECK(!grid->is_recording());
+        destroy_grid(grid);
+    }
+
+    ReplayPlayer player(PATH);
+    CHECK(player.rows() == ROWS);
+    CHECK(player.cols() == COLS);
+    CHECK(player.frames() == static_cast<std::uint32_t>(FRAMES));
+    CHECK(player.keyframes() == (FRAMES + KEYFRAME_INTERVAL - 1) / KEYFRAME_INTERVAL);
+
+    // playing through shows each frame in turn into the same grid
+    auto grid = create_grid(ROWS, COLS, "recording_test");
+    for (int frame = 0; frame < FRAMES; ++frame)
+    {
+        CHECK(player.frame() == static_cast<std::uint32_t>(frame));
+        player.show(*grid);
+        CHECK(is_same(snapshot(*grid), expected[frame]));
+        CHECK(player.step() == (frame + 1 < FRAMES));
+    }
+
+    CHECK(player.is_finished());
+    destroy_grid(grid);
+
+    // seeking lands on the same frames, whether or not they are keyframes
+    for (int frame : {FRAMES - 1, 0, 50, 49, 14, 63, 7})
+    {
+        player.seek(frame);
+        compare(player, expected[frame]);
+    }
+
+    player.seek_keyframe(3);
+    CHECK(player.frame() == 3 * KEYFRAME_INTERVAL);
+    compare(player, expected[3 * KEYFRAME_INTERVAL]);
+
+    // an index without keyframes, or whose first keyframe is not frame 0,
+    // would leave frames which cannot be decoded
+    CHECK(!is_rejected(12, (FRAMES + KEYFRAME_INTERVAL - 1) / KEYFRAME_INTERVAL));
+    CHECK(is_rejected(12, 0));
+    CHECK(is_rejected(16, 5));
+
+    std::remove(PATH);
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include "glasskey/glasskey.h"
+#include "check.h"
+
+#include <random>
+
+using namespace gk;
+
+namespace
+{
+const Size ROWS = 24;
+const Size COLS = 40;
+const int STEPS = 200;
+
+/** Renders a copy of the grid into a grid of its own, which draws every
+ *  cell from scratch.
+ */
+Image full_redraw(const TextGrid &grid)
+{
+    auto copy = create_grid(ROWS, COLS, "scroll_test");
+    for (Size row = 0; row < ROWS; ++row)
+    {
+        std::vector<Letter> letters;
+        for (Size col = 0; col < COLS; ++col)
+        {
+            letters.push_back(grid.get_letter(row, col));
+        }
+
+        copy->draw(row, 0, letters);
+    }
+
+    copy->blit();
+    Image image;
+    CHECK(read_pixels(copy, image));
+    destroy_grid(copy);
+    return image;
+}
+} // namespace
+
+int main()
+{
+    set_backend(BackendType::HEADLESS);
+    start();
+
+    std::mt19937 random(17);
+    auto grid = create_grid(ROWS, COLS, "scroll_test");
+    for (Size row = 0; row < ROWS; ++row)
+    {
+        grid->draw(row, 0, std::string(COLS, static_cast<char>('a' + row)));
+    }
+
+    grid->blit();
+    Image image;
+    CHECK(read_pixels(grid, image));
+    for (int step = 0; step < STEPS; ++step)
+    {
+        // sometimes several scrolls are published in one frame
+        int scrolls = 1 + random() % 3;
+        for (int i = 0; i < scrolls; ++i)
+        {
+            Index rows = static_cast<Index>(random() % 7) - 3;
+            switch (random() % 3)
+            {
+            case 0:
+                // whole rows, which only reorders them
+                grid->scroll(Rect(0, 0, COLS, ROWS), rows);
+                break;
+
+            case 1:
+            {
+                // a band of whole rows
+                Index top = random() % (ROWS - 2);
+                Size height = 2 + random() % (ROWS - top - 1);
+                grid->scroll(Rect(0, top, COLS, height), rows);
+                break;
+            }
+
+            default:
+            {
+                // a region, which moves cells within the rows
+                Index top = random() % (ROWS - 4);
+                Index left = random() % (COLS - 4);
+                grid->scroll(Rect(left, top, 4 + random() % (COLS - left - 3), 4 + random() % (ROWS - top - 3)),
+                             rows, static_cast<Index>(random() % 5) - 2);
+                break;
+            }
+            }
+
+            // new content in the rows left behind
+            Index row = random() % ROWS;
+            grid->draw(row, random() % COLS, std::to_string(step));
+        }
+
+        grid->blit();
+
+        // the render thread may already have drawn the frame, which is fine
+        CHECK(read_pixels(grid, image));
+        Image expected = full_redraw(*grid);
+        CHECK(image.width == expected.width);
+        CHECK(image.height == expected.height);
+        CHECK(image.pixels == expected.pixels);
+    }
+
+    destroy_grid(grid);
+    stop();
+    return 0;
+}
@@ -0,0 +1,171 @@
+#include "glasskey/glasskey.h"
+#include "check.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+using namespace gk;
+
+namespace
+{
+// not a multiple of the tile size, so the last tiles are partly outside the map
+const std::uint32_t ROWS = 700;
+const std::uint32_t COLS = 450;
+const std::size_t MAX_TILES = 12;
+const char *PATH = "tile_map_test.gkmp";
+
+/** What the map holds at a cell: sparse text rows, colored rows, and a
+ *  blank band which is left out of the file.
+ */
+Letter expected(std::uint32_t row, std::uint32_t col)
+{
+    if (row >= 600)
+    {
+        return Letter(' ', Colors::White);
+    }
+
+    if (row % 3 == 0)
+    {
+        return Letter(col % 7 == 0 ? static_cast<char>('a' + (row + col) % 26) : ' ', Colors::White);
+    }
+
+    if (row < 300 && col < 200)
+    {
+        return Letter(static_cast<char>('A' + col % 26), col % 2 ? Colors::Red : Colors::Blue);
+    }
+
+    return Letter(' ', Colors::White);
+}
+
+void write_map()
+{
+    TileMapWriter writer(PATH, ROWS, COLS);
+    for (std::uint32_t row = 0; row < 600; ++row)
+    {
+        if (row % 3 == 0)
+        {
+            std::string values(COLS, ' ');
+            for (std::uint32_t col = 0; col < COLS; ++col)
+            {
+                values[col] = expected(row, col).value();
+            }
+
+            writer.write_row(values);
+        }
+        else if (row < 300)
+        {
+            std::vector<Letter> letters;
+            for (std::uint32_t col = 0; col < 200; ++col)
+            {
+                letters.push_back(expected(row, col));
+            }
+
+            writer.write_row(letters);
+        }
+        else
+        {
+            writer.write_row("");
+        }
+    }
+
+    // the rows which are not written are blank
+    writer.close();
+}
+
+void check_cell(const WorldGrid &world, std::uint32_t row, std::uint32_t col)
+{
+    Letter letter = world.get_letter(row, col);
+    Letter letter_expected = expected(row, col);
+    CHECK(letter.value() == letter_expected.value());
+    CHECK(letter.value() == ' ' || letter.color() == letter_expected.color());
+}
+
+bool is_rejected(const std::shared_ptr<WorldGrid> &world)
+{
+    try
+    {
+        MapStreamer streamer(PATH, world);
+    }
+    catch (const std::runtime_error &)
+    {
+        return true;
+    }
+
+    return false;
+}
+} // namespace
+
+int main()
+{
+    write_map();
+    auto world = std::make_shared<WorldGrid>();
+    {
+        MapStreamer streamer(PATH, world, MAX_TILES);
+        CHECK(streamer.rows() == ROWS);
+        CHECK(streamer.cols() == COLS);
+
+        // every cell read back through a small view, tile by tile
+        for (std::uint32_t row = 0; row < ROWS; row += 5)
+        {
+            for (std::uint32_t col = 0; col < COLS; col += 3)
+            {
+                streamer.update(row, col, 1, 1);
+                streamer.wait();
+                check_cell(*world, row, col);
+            }
+        }
+
+        // moving the view keeps the tiles loaded within the limit
+        for (std::int32_t top = -50; top < static_cast<std::int32_t>(ROWS); top += 17)
+        {
+            streamer.update(top, top / 2, 100, 100);
+            streamer.wait();
+            CHECK(streamer.loaded_tiles() <= MAX_TILES);
+            CHECK(world->chunk_count() <= MAX_TILES);
+            check_cell(*world, std::max(top, 0) + 10, std::max(top / 2, 0) + 10);
+        }
+
+        // a chunk the application draws into is neither overwritten nor evicted
+        streamer.update(0, 0, 10, 10);
+        streamer.wait();
+        world->draw(1, 1, "drawn");
+        streamer.update(0, 0, 10, 10);
+        streamer.wait();
+        for (std::uint32_t row = 0; row < ROWS; row += WORLD_CHUNK_SIZE)
+        {
+            streamer.update(row, 300, 10, 10);
+            streamer.wait();
+        }
+
+        CHECK(world->get_letter(1, 1).value() == 'd');
+        CHECK(world->get_letter(0, 0).value() == expected(0, 0).value());
+    }
+
+    // an index offset which wraps around to 0 when the index size is added to it
+    {
+        std::uint64_t tiles = ((ROWS + WORLD_CHUNK_SIZE - 1) / WORLD_CHUNK_SIZE) * ((COLS + WORLD_CHUNK_SIZE - 1) / WORLD_CHUNK_SIZE);
+        std::uint64_t offset = 0 - tiles * 8;
+        char bytes[8];
+        for (std::size_t i = 0; i < sizeof(bytes); ++i)
+        {
+            bytes[i] = static_cast<char>(offset >> (i * 8));
+        }
+
+        std::fstream file(PATH, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(16);
+        file.write(bytes, sizeof(bytes));
+    }
+
+    CHECK(is_rejected(world));
+
+    {
+        std::ofstream file(PATH, std::ios::binary | std::ios::trunc);
+        file << "not a tile map, but long enough to have a header";
+    }
+
+    CHECK(is_rejected(world));
+    std::remove(PATH);
+    return 0;
+}